@@ -1,5 +1,7 @@
 #pragma once
 #include "Utility/Config.h"
+#include "Utility/NodeProfiler.h"
+#include "Utility/GenerationTracer.h"
 
 // Node class definitions
 #include "Generators/BasicGenerators.h"
@@ -63,4 +65,69 @@ namespace FastNoise
      *  @return Root node of the deserialised tree, or nullptr if the string is invalid.
      */
     FASTNOISE_API SmartNode<> NewFromEncodedNodeTree( const char* encodedNodeTreeString, FastSIMD::FeatureSet maxFeatureSet = FastSIMD::FeatureSet::Max );
+
+    /** @brief Create a tree of FastNoise nodes from an encoded string with every node in one contiguous arena.
+     *
+     *  Nodes are laid out in evaluation order, parents directly before their sources, which reduces
+     *  cache misses when generating from deep trees. The arena memory is released as a unit once
+     *  every node in the tree has been released. Setting new sources on nodes in the tree is still allowed,
+     *  nodes created afterwards are allocated from the regular pools.
+     *  The arena is sized from the node types in the string before any node is created.
+     *
+     *  @param  encodedNodeTreeString  Encoded node tree string.
+     *  @param  maxFeatureSet          Maximum SIMD feature set to use. Defaults to auto-detect.
+     *  @return Root node of the deserialised tree, or nullptr if the string is invalid.
+     *  @see SmartNodeManager::ArenaScope
+     */
+    FASTNOISE_API SmartNode<> NewFromEncodedNodeTreeInArena( const char* encodedNodeTreeString, FastSIMD::FeatureSet maxFeatureSet = FastSIMD::FeatureSet::Max );
+
+    /** @brief Create a tree of FastNoise nodes from the compact binary format.
+     *
+     *  Reads parameters directly from the buffer, no decoding pass or copy is required,
+     *  so it can be used on memory mapped files or network buffers. Every record is bounds checked,
+     *  the buffer does not need to be aligned and must only stay valid for the duration of the call.
+     *  Binary node trees are created with Metadata::SerialiseNodeDataBinary().
+     *
+     *  @param  binaryNodeTree  Pointer to the binary node tree.
+     *  @param  size            Size of the buffer in bytes.
+     *  @param  maxFeatureSet   Maximum SIMD feature set to use. Defaults to auto-detect.
+     *  @return Root node of the deserialised tree, or nullptr if the buffer is invalid.
+     */
+    FASTNOISE_API SmartNode<> NewFromBinaryNodeTree( const void* binaryNodeTree, size_t size, FastSIMD::FeatureSet maxFeatureSet = FastSIMD::FeatureSet::Max );
+
+    /** @brief Get a shared, immutable node tree for an encoded string from a process-wide cache.
+     *
+     *  Trees are cached by (encoded string, maxFeatureSet). Repeated calls with the same key
+     *  return the same root node instead of deserialising again.
+     *  Generation is const and thread-safe, so the returned tree can be shared across threads.
+     *  The cache is thread-safe and evicts the least recently used tree once it reaches its capacity.
+     *
+     *  @param  encodedNodeTreeString  Encoded node tree string.
+     *  @param  maxFeatureSet          Maximum SIMD feature set to use. Defaults to auto-detect.
+     *  @return Root node of the cached tree, or nullptr if the string is invalid (invalid strings are not cached).
+     */
+    FASTNOISE_API SmartNode<const Generator> NewFromEncodedNodeTreeCached( const char* encodedNodeTreeString, FastSIMD::FeatureSet maxFeatureSet = FastSIMD::FeatureSet::Max );
+
+    /** @brief Usage statistics for the encoded node tree cache. */
+    struct EncodedNodeTreeCacheStats
+    {
+        size_t hits = 0;      ///< Lookups that returned a cached tree.
+        size_t misses = 0;    ///< Lookups that deserialised a new tree.
+        size_t evictions = 0; ///< Trees removed to stay within capacity.
+        size_t size = 0;      ///< Trees currently cached.
+        size_t capacity = 0;  ///< Maximum number of cached trees.
+    };
+
+    /** @brief Set the maximum number of trees held by the encoded node tree cache.
+     *  Evicts least recently used trees if the cache is above the new capacity. 0 disables caching.
+     */
+    FASTNOISE_API void SetEncodedNodeTreeCacheCapacity( size_t capacity );
+
+    /** @brief Get hit/miss statistics for the encoded node tree cache. */
+    FASTNOISE_API EncodedNodeTreeCacheStats GetEncodedNodeTreeCacheStats();
+
+    /** @brief Remove all trees from the encoded node tree cache and reset statistics.
+     *  Trees still referenced elsewhere stay alive until released.
+     */
+    FASTNOISE_API void ClearEncodedNodeTreeCache();
 }
@@ -43,6 +43,18 @@ FASTNOISE_API unsigned fnGetActiveFeatureSet( const void* node );
  */
 FASTNOISE_API int fnGetMetadataID( const void* node );
 
+/** @brief Estimate the cost of generating noise with this node tree.
+ *
+ *  Sums the estimated per sample cost of all nodes in the tree, including fractal octaves.
+ *  The shipped cost table is uncalibrated, so only compare estimates with each other.
+ *  Multiply by the sample count to estimate generation time, useful for sizing and balancing work units.
+ *
+ *  @param node        Node handle (must be the root of the node tree).
+ *  @param dimensions  Number of generated dimensions: 2, 3 or 4.
+ *  @return Estimated nanoseconds per sample, 0 if @p dimensions is out of range.
+ */
+FASTNOISE_API float fnEstimateCost( const void* node, int dimensions );
+
 /** @brief Generate a 2D uniform grid of noise values.
  *
  *  Fills @p noiseOut with noise sampled on a regular 2D grid. Ideal for
@@ -252,6 +264,75 @@ FASTNOISE_API void fnGenTileable2D( const void* node, float* noiseOut,
                                     float xStepSize, float yStepSize,
                                     int seed, float* outputMinMax /*nullptr or float[2]*/ );
 
+/** @brief Description of one uniform grid generation job for the batch functions.
+ *
+ *  Fill one entry per chunk and submit them all with fnGenUniformGridBatch() or
+ *  fnGenUniformGridBatchSubmit(). Unused dimensions are ignored, for example a 2D job
+ *  only reads the first two elements of @p offset, @p count and @p stepSize.
+ *  Output layout matches fnGenUniformGrid2D/3D/4D().
+ */
+typedef struct fnUniformGridJob
+{
+    const void* node;      /**< Node handle (must be the root of the node tree). */
+    float* noiseOut;       /**< Pre-allocated output array, must hold the product of the used counts. */
+    int dimensions;        /**< 2, 3 or 4. */
+    int seed;              /**< Seed value for the noise. */
+    float offset[4];       /**< Starting X, Y, Z, W position in world space. */
+    int count[4];          /**< Number of samples along X, Y, Z, W. */
+    float stepSize[4];     /**< Distance between samples along X, Y, Z, W. */
+    float outputMinMax[2]; /**< Receives {min, max} of the generated values. */
+} fnUniformGridJob;
+
+/** @brief Task callback passed to a fnBatchSubmitFunc, run it once for every task index. */
+typedef void ( *fnBatchTaskFunc )( void* taskData, int taskIndex );
+
+/** @brief Caller-supplied task submission for fnGenUniformGridBatchSubmit().
+ *
+ *  Must call `task( taskData, i )` for every i in [0, taskCount), on any threads, and only return once all calls have finished.
+ *
+ *  @param userData   The userData pointer passed to fnGenUniformGridBatchSubmit().
+ *  @param task       Function to run for each task index.
+ *  @param taskData   Opaque data to pass to @p task.
+ *  @param taskCount  Number of tasks to run.
+ */
+typedef void ( *fnBatchSubmitFunc )( void* userData, fnBatchTaskFunc task, void* taskData, int taskCount );
+
+/** @brief Generate a batch of uniform grids in parallel on the internal worker pool.
+ *
+ *  Submits all jobs in a single call, the calling thread also works on jobs and returns once all jobs are complete.
+ *  The worker pool is created on first use with one thread per hardware thread and is shared by all batch calls.
+ *  It is not destroyed at exit, call fnShutdownBatchPool() before unloading the library.
+ *  Jobs are validated before any are run.
+ *
+ *  @param jobs        Array of jobs, outputMinMax of each job is written on completion.
+ *  @param jobCount    Number of jobs in @p jobs.
+ *  @param maxThreads  Maximum number of threads working on this batch including the calling thread, 0 for no limit.
+ *  @return false if any job has a NULL node/output, an invalid dimension count or a negative count, in which case nothing is generated.
+ */
+FASTNOISE_API bool fnGenUniformGridBatch( fnUniformGridJob* jobs, int jobCount, int maxThreads );
+
+/** @brief Stop and join the worker threads used by fnGenUniformGridBatch().
+ *
+ *  The pool is never torn down automatically, since joining threads from static destructors can deadlock
+ *  (for example under the Windows loader lock during DLL unload). Call this before unloading the library,
+ *  and not from DllMain or an atexit handler. Batches still running finish first, the last one to finish joins the threads.
+ *  A later fnGenUniformGridBatch() call creates a new pool.
+ */
+FASTNOISE_API void fnShutdownBatchPool();
+
+/** @brief Generate a batch of uniform grids using a caller-supplied task system.
+ *
+ *  Use this to run jobs on an existing thread pool or job system instead of the internal worker pool.
+ *  @p submit is called once with one task per job.
+ *
+ *  @param jobs      Array of jobs, outputMinMax of each job is written on completion.
+ *  @param jobCount  Number of jobs in @p jobs.
+ *  @param submit    Task submission callback, see fnBatchSubmitFunc.
+ *  @param userData  Passed through to @p submit.
+ *  @return false if @p submit is NULL or any job is invalid, in which case nothing is generated.
+ */
+FASTNOISE_API bool fnGenUniformGridBatchSubmit( fnUniformGridJob* jobs, int jobCount, fnBatchSubmitFunc submit, void* userData );
+
 /** @brief Generate a single 2D noise value at a specific position. VERY SLOW!!!
  *
  *  Avoid using this unless you only need a single sample, this is significantly slower
@@ -297,6 +378,48 @@ FASTNOISE_API float fnGenSingle3D( const void* node, float x, float y, float z,
  */
 FASTNOISE_API float fnGenSingle4D( const void* node, float x, float y, float z, float w, int seed );
 
+/** @brief Time spent in one node of a profiled call tree, see fnGetNodeProfile(). */
+typedef struct fnNodeProfile
+{
+    int metadataId;              /**< Node type, use with fnGetMetadataName() etc. */
+    int parent;                  /**< Index of the calling node, -1 for generation call roots. */
+    int depth;                   /**< Call depth, 0 for generation call roots. */
+    unsigned long long calls;    /**< Generation calls for roots, SIMD vector evaluations for source nodes. */
+    unsigned long long samples;  /**< Samples generated by this node. */
+    double inclusiveNs;          /**< Time spent in this node and its sources. */
+    double exclusiveNs;          /**< Time spent in this node, excluding its sources. */
+} fnNodeProfile;
+
+/** @brief Start recording per-node generation time on all threads, discarding previous results.
+ *
+ *  Equivalent to FastNoise::NodeProfiler::Begin() in the C++ API. Only available when the
+ *  library is built with the FASTNOISE2_PROFILING CMake option, which slows down generation.
+ *
+ *  @return false if profiling instrumentation is not available in this build.
+ */
+FASTNOISE_API bool fnBeginNodeProfiling();
+
+/** @brief Stop recording per-node generation time. Results stay available until the next fnBeginNodeProfiling(). */
+FASTNOISE_API void fnEndNodeProfiling();
+
+/** @brief Get the recorded call tree in depth first order, children follow their parent.
+ *
+ *  @param rootNode    Only include generation calls made on this node handle, NULL for all calls.
+ *  @param profileOut  Receives up to @p maxCount entries. May be NULL to query the count.
+ *  @param maxCount    Size of @p profileOut.
+ *  @return Total number of entries, may be larger than @p maxCount.
+ */
+FASTNOISE_API int fnGetNodeProfile( const void* rootNode, fnNodeProfile* profileOut, int maxCount );
+
+/** @brief Format the recorded call tree as an indented table keyed by formatted node name.
+ *
+ *  @param rootNode    Only include generation calls made on this node handle, NULL for all calls.
+ *  @param buffer      Receives the null terminated table, truncated to fit. May be NULL to query the size.
+ *  @param bufferSize  Size of @p buffer in bytes.
+ *  @return Buffer size required for the full table including the null terminator.
+ */
+FASTNOISE_API int fnFormatNodeProfile( const void* rootNode, char* buffer, int bufferSize );
+
 /** @brief Get the total number of registered node types.
  *
  *  Each node type has a unique metadata ID. Use this to determine the valid
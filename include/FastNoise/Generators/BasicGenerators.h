@@ -230,6 +230,11 @@ namespace FastNoise
         template<Dim D>
         void SetOffset( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mOffset[(int)D], gen ); }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimatePerDimensionSourceCost( mOffset, dimensions );
+        }
+
     protected:
         PerDimensionVariable<float> mMultiplier = 0.0f;
         PerDimensionVariable<HybridSource> mOffset = 0.0f;
@@ -283,6 +288,11 @@ namespace FastNoise
         template<Dim D>
         void SetPoint( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mPoint[(int)D], gen ); }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mMinkowskiP, dimensions ) + EstimatePerDimensionSourceCost( mPoint, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
         HybridSource mMinkowskiP = 1.5f;
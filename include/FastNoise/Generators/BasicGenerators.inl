@@ -18,6 +18,12 @@ protected:
         float32v vFrequency( mFrequency );
         ( (pos *= vFrequency), ... );
     }
+
+    // Sample footprint after frequency scaling, 0 if LOD approximation is not enabled for this generation call
+    FS_FORCEINLINE float GetLodLatticeFootprint() const
+    {
+        return this->IsLodApproximationEnabled() ? this->GetSampleFootprint() * std::abs( mFrequency ) : 0.0f;
+    }
 };
 
 template<FastSIMD::FeatureSet SIMD, typename PARENT>
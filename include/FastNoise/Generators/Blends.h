@@ -2,6 +2,7 @@
 #include "Generator.h"
 
 #include <climits>
+#include <utility>
 
 namespace FastNoise
 {
@@ -12,6 +13,11 @@ namespace FastNoise
         void SetRHS( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mRHS, gen ); }
         void SetRHS( float value ) { mRHS = value; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mLHS, dimensions ) + EstimateSourceCost( mRHS, dimensions );
+        }
+
     protected:
         GeneratorSource mLHS;
         HybridSource mRHS = 0.0f;
@@ -38,6 +44,11 @@ namespace FastNoise
         void SetRHS( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mRHS, gen ); }
         void SetRHS( float value ) { mRHS = value; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mLHS, dimensions ) + EstimateSourceCost( mRHS, dimensions );
+        }
+
     protected:
         HybridSource mLHS = 0.0f;
         HybridSource mRHS = 0.0f;
@@ -68,7 +79,10 @@ namespace FastNoise
     {
         SmartNode<> CreateNode( FastSIMD::FeatureSet ) const override;
 
-        MetadataT() : MetadataT<OperatorSourceLHS>( "Operators" ) {}
+        MetadataT() : MetadataT<OperatorSourceLHS>( "Operators" )
+        {
+            commutativeOperands = true;
+        }
     };
 #endif
 
@@ -100,7 +114,10 @@ namespace FastNoise
     {
         SmartNode<> CreateNode( FastSIMD::FeatureSet ) const override;
 
-        MetadataT() : MetadataT<OperatorSourceLHS>( "Operators" ) {}
+        MetadataT() : MetadataT<OperatorSourceLHS>( "Operators" )
+        {
+            commutativeOperands = true;
+        }
     };
 #endif
 
@@ -147,6 +164,11 @@ namespace FastNoise
     struct MetadataT<Min> : MetadataT<OperatorSourceLHS>
     {
         SmartNode<> CreateNode( FastSIMD::FeatureSet ) const override;
+
+        MetadataT()
+        {
+            commutativeOperands = true;
+        }
     };
 #endif
 
@@ -161,6 +183,11 @@ namespace FastNoise
     struct MetadataT<Max> : MetadataT<OperatorSourceLHS>
     {
         SmartNode<> CreateNode( FastSIMD::FeatureSet ) const override;
+
+        MetadataT()
+        {
+            commutativeOperands = true;
+        }
     };
 #endif
 
@@ -174,6 +201,11 @@ namespace FastNoise
         void SetPow( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mPow, gen ); }
         void SetPow( float value ) { mPow = value; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mValue, dimensions ) + EstimateSourceCost( mPow, dimensions );
+        }
+
     protected:
         HybridSource mValue = 2.0f;
         HybridSource mPow = 2.0f;
@@ -204,6 +236,11 @@ namespace FastNoise
         void SetValue( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mValue, gen ); }
         void SetPow( int value ) { mPow = value; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mValue, dimensions );
+        }
+
     protected:
         GeneratorSource mValue;
         int mPow = 2;
@@ -234,6 +271,11 @@ namespace FastNoise
         void SetSmoothness( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mSmoothness, gen ); }
         void SetSmoothness( float value ) { mSmoothness = value; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return OperatorSourceLHS::EstimateCost( dimensions ) + EstimateSourceCost( mSmoothness, dimensions );
+        }
+
     protected:
         HybridSource mSmoothness = 0.1f;
     };
@@ -247,6 +289,7 @@ namespace FastNoise
         MetadataT()
         {
             this->AddHybridSource( "Smoothness", 0.1f, &MinSmooth::SetSmoothness, &MinSmooth::SetSmoothness );
+            commutativeOperands = true;
 
             description = 
                 "Quadratic Smooth Minimum\n"
@@ -265,6 +308,11 @@ namespace FastNoise
         void SetSmoothness( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mSmoothness, gen ); }
         void SetSmoothness( float value ) { mSmoothness = value; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return OperatorSourceLHS::EstimateCost( dimensions ) + EstimateSourceCost( mSmoothness, dimensions );
+        }
+
     protected:
         HybridSource mSmoothness = 0.1f;  
     };
@@ -278,6 +326,7 @@ namespace FastNoise
         MetadataT()
         {
             this->AddHybridSource( "Smoothness", 0.1f, &MaxSmooth::SetSmoothness, &MaxSmooth::SetSmoothness );
+            commutativeOperands = true;
 
             description =
                 "Quadratic Smooth Maximum\n"
@@ -313,6 +362,11 @@ namespace FastNoise
 
         void SetInterpolation( Interpolation interpolation ) { mInterpolation = interpolation; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mA, dimensions ) + EstimateSourceCost( mB, dimensions ) + EstimateSourceCost( mFade, dimensions ) + EstimateSourceCost( mFadeMin, dimensions ) + EstimateSourceCost( mFadeMax, dimensions );
+        }
+
     protected:
         GeneratorSource mA;
         GeneratorSource mB;
@@ -345,4 +399,128 @@ namespace FastNoise
         }
     };
 #endif
+
+    class Select : public virtual Generator
+    {
+    public:
+        const Metadata& GetMetadata() const override;
+        void SetCondition( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mCondition, gen ); }
+        void SetA( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mA, gen ); }
+        void SetB( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mB, gen ); }
+
+        void SetThreshold( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mThreshold, gen ); }
+        void SetThreshold( float value ) { mThreshold = value; }
+
+        void SetFalloff( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mFalloff, gen ); }
+        void SetFalloff( float value ) { mFalloff = value; }
+
+        // Assumes most vectors only need one of A or B
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mCondition, dimensions ) + EstimateSourceCost( mThreshold, dimensions ) + EstimateSourceCost( mFalloff, dimensions ) +
+                std::max( EstimateSourceCost( mA, dimensions ), EstimateSourceCost( mB, dimensions ) );
+        }
+
+    protected:
+        GeneratorSource mCondition;
+        GeneratorSource mA;
+        GeneratorSource mB;
+        HybridSource mThreshold = 0.0f;
+        HybridSource mFalloff = 0.0f;
+    };
+
+#ifdef FASTNOISE_METADATA
+    template<>
+    struct MetadataT<Select> : MetadataT<Generator>
+    {
+        SmartNode<> CreateNode( FastSIMD::FeatureSet ) const override;
+
+        MetadataT()
+        {
+            groups.push_back( "Blends" );
+            this->AddGeneratorSource( { "Condition", "Compared against the threshold to select A or B" }, &Select::SetCondition );
+            this->AddGeneratorSource( { "A", "Output where Condition is below Threshold" }, &Select::SetA );
+            this->AddGeneratorSource( { "B", "Output where Condition is above Threshold" }, &Select::SetB );
+            this->AddHybridSource( "Threshold", 0.0f, &Select::SetThreshold, &Select::SetThreshold );
+            this->AddHybridSource( { "Falloff", "Width of the smooth blend either side of Threshold, 0 for a hard switch" }, 0.0f, &Select::SetFalloff, &Select::SetFalloff );
+
+            description =
+                "Outputs A where Condition is below Threshold and B where it is above\n"
+                "Only evaluates A or B if at least one sample in a SIMD vector uses it\n"
+                "Falloff smoothly blends A and B within Threshold +/- Falloff";
+        }
+    };
+#endif
+
+    class Switch : public virtual Generator
+    {
+    public:
+        static constexpr int kMaxSources = 8;
+
+        const Metadata& GetMetadata() const override;
+        void SetControl( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mControl, gen ); }
+        void SetControlMin( float value ) { mControlMin = value; }
+        void SetControlMax( float value ) { mControlMax = value; }
+        void SetSourceCount( int value ) { mSourceCount = std::min( std::max( value, 1 ), kMaxSources ); }
+
+        void SetSource( int index, SmartNodeArg<> gen ) { if( index >= 0 && index < kMaxSources ) this->SetSourceMemberVariable( mSources[index], gen ); }
+        void SetSource( int index, float value ) { if( index >= 0 && index < kMaxSources ) mSources[index] = value; }
+
+        template<int I>
+        void SetSourceNode( SmartNodeArg<> gen ) { SetSource( I, gen ); }
+        template<int I>
+        void SetSourceValue( float value ) { SetSource( I, value ); }
+
+        // Assumes most vectors only need one source
+        float EstimateCost( int dimensions ) const override
+        {
+            float sourceCost = 0.0f;
+            for( int i = 0; i < mSourceCount; i++ )
+            {
+                sourceCost = std::max( sourceCost, EstimateSourceCost( mSources[i], dimensions ) );
+            }
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mControl, dimensions ) + sourceCost;
+        }
+
+    protected:
+        GeneratorSource mControl;
+        float mControlMin = -1.0f;
+        float mControlMax = 1.0f;
+        int mSourceCount = 4;
+        HybridSource mSources[kMaxSources] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+    };
+
+#ifdef FASTNOISE_METADATA
+    template<>
+    struct MetadataT<Switch> : MetadataT<Generator>
+    {
+        SmartNode<> CreateNode( FastSIMD::FeatureSet ) const override;
+
+        MetadataT()
+        {
+            groups.push_back( "Blends" );
+            this->AddGeneratorSource( { "Control", "Selects which source to output" }, &Switch::SetControl );
+            this->AddVariable( { "Control Min", "Control values at or below this select Source 0" }, -1.0f, &Switch::SetControlMin );
+            this->AddVariable( { "Control Max", "Control values at or above this select the last source" }, 1.0f, &Switch::SetControlMax );
+            this->AddVariable( { "Source Count", "Number of sources used, starting from Source 0" }, 4, &Switch::SetSourceCount, 1, Switch::kMaxSources );
+            AddSources( std::make_integer_sequence<int, Switch::kMaxSources>() );
+
+            description =
+                "Outputs one of the sources based on the Control value\n"
+                "The range Control Min to Control Max is split evenly between Source Count sources\n"
+                "Only evaluates sources used by at least one sample in a SIMD vector\n"
+                "Useful for biome selection";
+        }
+
+    private:
+        template<int... I>
+        void AddSources( std::integer_sequence<int, I...> )
+        {
+            static const char* const kSourceNames[] = { "Source 0", "Source 1", "Source 2", "Source 3", "Source 4", "Source 5", "Source 6", "Source 7" };
+            static_assert( sizeof( kSourceNames ) / sizeof( *kSourceNames ) == Switch::kMaxSources );
+
+            ( this->AddHybridSource( kSourceNames[I], (float)I, &Switch::SetSourceNode<I>, &Switch::SetSourceValue<I> ), ... );
+        }
+    };
+#endif
 }
@@ -193,8 +193,91 @@ class FastSIMD::DispatchClass<Fade, SIMD> final : public virtual Fade, public Di
 
         // Protect against nan from 0 range div
         fade = FS::Select( fadeRange == float32v( 0 ), float32v( 0.5f ), fade );
-        
-        return Lerp( this->GetSourceValue( mA, seed, pos... ), this->GetSourceValue( mB, seed, pos... ), fade );
+
+        // Only evaluate the source in use when every lane is fully A or fully B, common away from blend borders
+        if( !FS::AnyMask( fade != float32v( 0 ) ) )
+        {
+            return this->GetSourceValue( mA, seed, pos... );
+        }
+        if( !FS::AnyMask( fade != float32v( 1 ) ) )
+        {
+            return this->GetSourceValue( mB, seed, pos... );
+        }
+
+        float32v a = this->GetSourceValue( mA, seed, pos... );
+        float32v b = this->GetSourceValue( mB, seed, pos... );
+
+        // Saturated lanes output the source exactly, so results do not depend on which lanes share a vector
+        return FS::Select( fade == float32v( 0 ), a, FS::Select( fade == float32v( 1 ), b, Lerp( a, b, fade ) ) );
+    }
+};
+
+
+template<FastSIMD::FeatureSet SIMD>
+class FastSIMD::DispatchClass<Select, SIMD> final : public virtual Select, public DispatchClass<Generator, SIMD>
+{
+    FASTNOISE_IMPL_GEN_T;
+    
+    template<typename... P> 
+    FS_FORCEINLINE float32v GenT( int32v seed, P... pos ) const
+    {
+        float32v condition = this->GetSourceValue( mCondition, seed, pos... );
+        float32v threshold = this->GetSourceValue( mThreshold, seed, pos... );
+        float32v falloff = FS::Max( this->GetSourceValue( mFalloff, seed, pos... ), float32v( 0 ) );
+
+        // 0 falloff divides by FLT_MIN, which saturates to a hard switch at the threshold
+        float32v t = ( condition - threshold + falloff ) / FS::Max( falloff + falloff, float32v( FLT_MIN ) );
+
+        t = InterpHermite( FS::Max( float32v( 0 ), FS::Min( float32v( 1 ), t ) ) );
+
+        // Only evaluate the sources used by at least one lane
+        if( !FS::AnyMask( t != float32v( 0 ) ) )
+        {
+            return this->GetSourceValue( mA, seed, pos... );
+        }
+        if( !FS::AnyMask( t != float32v( 1 ) ) )
+        {
+            return this->GetSourceValue( mB, seed, pos... );
+        }
+
+        float32v a = this->GetSourceValue( mA, seed, pos... );
+        float32v b = this->GetSourceValue( mB, seed, pos... );
+
+        return FS::Select( t == float32v( 0 ), a, FS::Select( t == float32v( 1 ), b, Lerp( a, b, t ) ) );
     }
 };
 
+template<FastSIMD::FeatureSet SIMD>
+class FastSIMD::DispatchClass<Switch, SIMD> final : public virtual Switch, public DispatchClass<Generator, SIMD>
+{
+    FASTNOISE_IMPL_GEN_T;
+    
+    template<typename... P> 
+    FS_FORCEINLINE float32v GenT( int32v seed, P... pos ) const
+    {
+        float controlRange = mControlMax - mControlMin;
+        float indexScale = controlRange != 0.0f ? (float)mSourceCount / controlRange : 0.0f;
+
+        float32v index = FS::Floor( ( this->GetSourceValue( mControl, seed, pos... ) - float32v( mControlMin ) ) * float32v( indexScale ) );
+
+        // NaN control uses source 0
+        index = FS::Select( index == index, index, float32v( 0 ) );
+        index = FS::Max( float32v( 0 ), FS::Min( float32v( (float)( mSourceCount - 1 ) ), index ) );
+
+        int32v sourceIdx = FS::Convert<int32_t>( index );
+        float32v result = float32v( 0 );
+
+        // Only evaluate the sources used by at least one lane
+        for( int i = 0; i < mSourceCount; i++ )
+        {
+            mask32v selected = sourceIdx == int32v( i );
+
+            if( FS::AnyMask( selected ) )
+            {
+                result = FS::Select( selected, this->GetSourceValue( mSources[i], seed, pos... ), result );
+            }
+        }
+
+        return result;
+    }
+};
@@ -19,6 +19,12 @@ namespace FastNoise
 
         void SetSizeJitter( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mSizeJitter, gen ); }
         void SetSizeJitter( float value ) { mSizeJitter = value; }
+
+        float EstimateCost( int dimensions ) const override
+        {
+            return PARENT::EstimateCost( dimensions ) + this->EstimateSourceCost( mMinkowskiP, dimensions ) + this->EstimateSourceCost( mGridJitter, dimensions ) + this->EstimateSourceCost( mSizeJitter, dimensions );
+        }
+
     protected:
         HybridSource mMinkowskiP = 1.5f;
         HybridSource mGridJitter = 1.0f;
@@ -138,6 +144,11 @@ namespace FastNoise
 
         void SetLookup( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mLookup, gen ); }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Cellular::EstimateCost( dimensions ) + EstimateSourceCost( mLookup, dimensions );
+        }
+
     protected:
         GeneratorSource mLookup;
     };
@@ -12,6 +12,12 @@ protected:
     static constexpr float kJitter3D = 0.396144f;
     static constexpr float kJitter4D = 0.366025f;
     static constexpr float kJitterIdx23 = 0.190983f;
+
+    // Size jitter is skipped when LOD approximation is enabled and cells are smaller than 2 samples
+    FS_FORCEINLINE bool IsSizeJitterActive() const
+    {
+        return ( this->mSizeJitter.simdGeneratorPtr || this->mSizeJitter.constant != 0.0f ) && !( this->GetLodLatticeFootprint() > 0.5f );
+    }
 };
 
 template<FastSIMD::FeatureSet SIMD>
@@ -23,7 +29,7 @@ class FastSIMD::DispatchClass<CellularValue, SIMD> final : public virtual Cellul
         seed += int32v( this->mSeedOffset );
         float32v jitter = float32v( this->kJitter2D ) * this->GetSourceValue( mGridJitter, sourceSeed, x, y );
         float32v sizeJitter;
-        bool sizeJitterActive = mSizeJitter.simdGeneratorPtr || mSizeJitter.constant != 0.0f;
+        bool sizeJitterActive = this->IsSizeJitterActive();
         if( sizeJitterActive )
         {
             sizeJitter = this->GetSourceValue( mSizeJitter, sourceSeed, x, y ) * float32v( -1.f / 0x3ff );
@@ -102,7 +108,7 @@ class FastSIMD::DispatchClass<CellularValue, SIMD> final : public virtual Cellul
         seed += int32v( this->mSeedOffset );
         float32v jitter = float32v( this->kJitter3D ) * this->GetSourceValue( mGridJitter, sourceSeed, x, y, z );
         float32v sizeJitter;
-        bool sizeJitterActive = mSizeJitter.simdGeneratorPtr || mSizeJitter.constant != 0.0f;
+        bool sizeJitterActive = this->IsSizeJitterActive();
         if( sizeJitterActive )
         {
             sizeJitter = this->GetSourceValue( mSizeJitter, sourceSeed, x, y, z ) * float32v( -1.f / 0xffff );
@@ -193,7 +199,7 @@ class FastSIMD::DispatchClass<CellularValue, SIMD> final : public virtual Cellul
         seed += int32v( this->mSeedOffset );
         float32v jitter = float32v( this->kJitter4D ) * this->GetSourceValue( mGridJitter, sourceSeed, x, y, z, w );
         float32v sizeJitter;
-        bool sizeJitterActive = mSizeJitter.simdGeneratorPtr || mSizeJitter.constant != 0.0f;
+        bool sizeJitterActive = this->IsSizeJitterActive();
         if( sizeJitterActive )
         {
             sizeJitter = this->GetSourceValue( mSizeJitter, sourceSeed, x, y, z, w ) * float32v( -1.f / 0xfffff );
@@ -300,7 +306,7 @@ class FastSIMD::DispatchClass<CellularDistance, SIMD> final : public virtual Cel
         seed += int32v( this->mSeedOffset );
         float32v jitter = float32v( this->kJitter2D ) * this->GetSourceValue( mGridJitter, sourceSeed, x, y );
         float32v sizeJitter;
-        bool sizeJitterActive = mSizeJitter.simdGeneratorPtr || mSizeJitter.constant != 0.0f;
+        bool sizeJitterActive = this->IsSizeJitterActive();
         if( sizeJitterActive )
         {
             sizeJitter = this->GetSourceValue( mSizeJitter, sourceSeed, x, y ) * float32v( -1.f / 0x3ff );
@@ -365,7 +371,7 @@ class FastSIMD::DispatchClass<CellularDistance, SIMD> final : public virtual Cel
         seed += int32v( this->mSeedOffset );
         float32v jitter = float32v( this->kJitter3D ) * this->GetSourceValue( mGridJitter, sourceSeed, x, y, z );
         float32v sizeJitter;
-        bool sizeJitterActive = mSizeJitter.simdGeneratorPtr || mSizeJitter.constant != 0.0f;
+        bool sizeJitterActive = this->IsSizeJitterActive();
         if( sizeJitterActive )
         {
             sizeJitter = this->GetSourceValue( mSizeJitter, sourceSeed, x, y, z ) * float32v( -1.f / 0xffff );
@@ -443,7 +449,7 @@ class FastSIMD::DispatchClass<CellularDistance, SIMD> final : public virtual Cel
         seed += int32v( this->mSeedOffset );
         float32v jitter = float32v( this->kJitter4D ) * this->GetSourceValue( mGridJitter, sourceSeed, x, y, z, w );
         float32v sizeJitter;
-        bool sizeJitterActive = mSizeJitter.simdGeneratorPtr || mSizeJitter.constant != 0.0f;
+        bool sizeJitterActive = this->IsSizeJitterActive();
         if( sizeJitterActive )
         {
             sizeJitter = this->GetSourceValue( mSizeJitter, sourceSeed, x, y, z, w ) * float32v( -1.f / 0xfffff );
@@ -574,7 +580,7 @@ class FastSIMD::DispatchClass<CellularLookup, SIMD> final : public virtual Cellu
         seed += int32v( this->mSeedOffset );
         float32v jitter = float32v( this->kJitter2D ) * this->GetSourceValue( mGridJitter, sourceSeed, x, y );
         float32v sizeJitter;
-        bool sizeJitterActive = mSizeJitter.simdGeneratorPtr || mSizeJitter.constant != 0.0f;
+        bool sizeJitterActive = this->IsSizeJitterActive();
         if( sizeJitterActive )
         {
             sizeJitter = this->GetSourceValue( mSizeJitter, sourceSeed, x, y ) * float32v( -1.f / 0x3ff );
@@ -639,7 +645,7 @@ class FastSIMD::DispatchClass<CellularLookup, SIMD> final : public virtual Cellu
         seed += int32v( this->mSeedOffset );
         float32v jitter = float32v( this->kJitter3D ) * this->GetSourceValue( mGridJitter, sourceSeed, x, y, z );
         float32v sizeJitter;
-        bool sizeJitterActive = mSizeJitter.simdGeneratorPtr || mSizeJitter.constant != 0.0f;
+        bool sizeJitterActive = this->IsSizeJitterActive();
         if( sizeJitterActive )
         {
             sizeJitter = this->GetSourceValue( mSizeJitter, sourceSeed, x, y, z ) * float32v( -1.f / 0xffff );
@@ -718,7 +724,7 @@ class FastSIMD::DispatchClass<CellularLookup, SIMD> final : public virtual Cellu
         seed += int32v( this->mSeedOffset );
         float32v jitter = float32v( this->kJitter4D ) * this->GetSourceValue( mGridJitter, sourceSeed, x, y, z, w );
         float32v sizeJitter;
-        bool sizeJitterActive = mSizeJitter.simdGeneratorPtr || mSizeJitter.constant != 0.0f;
+        bool sizeJitterActive = this->IsSizeJitterActive();
         if( sizeJitterActive )
         {
             sizeJitter = this->GetSourceValue( mSizeJitter, sourceSeed, x, y, z, w ) * float32v( -1.f / 0xfffff );
@@ -13,10 +13,26 @@ namespace FastNoise
         template<Dim D>
         void SetAmplitudeScaling( float value ) { mAxisScale[(int)D] = value; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions ) + EstimateSourceCost( mWarpAmplitude, dimensions );
+        }
+
     protected:
+        // Lattice noise sources that are generated inline after the warp instead of through a virtual call
+        // Set by the SIMD implementation when the source is assigned
+        enum class InlineSource : uint8_t
+        {
+            None,
+            Perlin,
+            Simplex,
+            SuperSimplex
+        };
+
         GeneratorSource mSource;
         HybridSource mWarpAmplitude = 50.0f;
         PerDimensionVariable<float> mAxisScale = 1.0f;
+        InlineSource mInlineSource = InlineSource::None;
 
         friend struct MetadataT<DomainWarp>;
     };
@@ -1,4 +1,6 @@
 #include "DomainWarp.h"
+#include "Perlin.h"
+#include "Simplex.h"
 #include "Utils.inl"
 
 template<FastSIMD::FeatureSet SIMD>
@@ -8,15 +10,84 @@ class FastSIMD::DispatchClass<DomainWarp, SIMD> : public virtual DomainWarp, pub
 
     template<typename... P>
     FS_FORCEINLINE float32v GenT( int32v seed, P... pos ) const
+    {
+        return GenWarpT( this, seed, pos... );
+    }
+
+protected:
+    // Warps the position then generates the source at the warped position
+    // With a final WarpT the warp kernel and lattice noise sources are inlined into a single function
+    template<typename WarpT, typename... P>
+    FS_FORCEINLINE float32v GenWarpT( const WarpT* warp, int32v seed, P... pos ) const
     {
         int32v sourceSeed = seed;
         seed += int32v( mSeedOffset );
-        Warp( seed, this->GetSourceValue( mWarpAmplitude, sourceSeed, pos... ), ( pos * float32v( this->mFrequency ) )..., pos... );
 
-        return this->GetSourceValue( mSource, sourceSeed, pos...);
+        float lodWeight = GetLodWarpWeight();
+        if( lodWeight > 0.0f )
+        {
+            float32v warpAmp = this->GetSourceValue( mWarpAmplitude, sourceSeed, pos... );
+            if( lodWeight < 1.0f )
+            {
+                warpAmp *= float32v( lodWeight );
+            }
+            warp->Warp( seed, warpAmp, ( pos * float32v( this->mFrequency ) )..., pos... );
+        }
+
+        auto* source = this->GetSourceSIMD( mSource );
+        FASTNOISE_PROFILE_NODE( source, float32v::ElementCount );
+
+        switch( mInlineSource )
+        {
+        case InlineSource::Perlin:
+            return static_cast<const FastSIMD::DispatchClass<Perlin, SIMD>*>( source )->Gen( sourceSeed, pos... );
+        case InlineSource::Simplex:
+            return static_cast<const FastSIMD::DispatchClass<Simplex, SIMD>*>( source )->Gen( sourceSeed, pos... );
+        case InlineSource::SuperSimplex:
+            return static_cast<const FastSIMD::DispatchClass<SuperSimplex, SIMD>*>( source )->Gen( sourceSeed, pos... );
+        default:
+            return source->Gen( sourceSeed, pos... );
+        }
+    }
+
+    // Records the source type when it is assigned, so nothing is checked per vector
+    void SetSourceSIMDPtr( const FastNoise::Generator* base, const void** simdPtr ) override
+    {
+        DispatchClass<Seeded<ScalableGenerator>, SIMD>::SetSourceSIMDPtr( base, simdPtr );
+
+        if( simdPtr == &mSource.simdGeneratorPtr )
+        {
+            if( dynamic_cast<const Perlin*>( base ) )
+                mInlineSource = InlineSource::Perlin;
+            else if( dynamic_cast<const Simplex*>( base ) )
+                mInlineSource = InlineSource::Simplex;
+            else if( dynamic_cast<const SuperSimplex*>( base ) )
+                mInlineSource = InlineSource::SuperSimplex;
+            else
+                mInlineSource = InlineSource::None;
+        }
+    }
+
+    // Warp amplitude weight for LOD approximation, fades out warps with a wavelength between 4 and 2 samples
+    FS_FORCEINLINE float GetLodWarpWeight() const
+    {
+        return std::min( std::max( 2.0f - this->GetLodLatticeFootprint() * 4.0f, 0.0f ), 1.0f );
     }
 
 public:
+    // Concrete warp implementation, allows warp fractals to select an inlined kernel once per call
+    enum class WarpKernel
+    {
+        Generic,
+        Gradient,
+        SimplexOrthogonalGradientMatrix,
+        SimplexGradientOuterProduct,
+        SuperSimplexOrthogonalGradientMatrix,
+        SuperSimplexGradientOuterProduct
+    };
+
+    virtual WarpKernel GetWarpKernel() const { return WarpKernel::Generic; }
+
     float GetWarpFrequency() const { return this->mFrequency; }
     const FastNoise::HybridSource& GetWarpAmplitude() const { return mWarpAmplitude; }
     const FastNoise::GeneratorSource& GetWarpSource() const { return mSource; }
@@ -29,7 +100,20 @@ public:
 template<FastSIMD::FeatureSet SIMD>
 class FastSIMD::DispatchClass<DomainWarpGradient, SIMD> final : public virtual DomainWarpGradient, public DispatchClass<DomainWarp, SIMD>
 {
+    FASTNOISE_IMPL_GEN_T;
+
+    template<typename... P>
+    FS_FORCEINLINE float32v GenT( int32v seed, P... pos ) const
+    {
+        return this->GenWarpT( this, seed, pos... );
+    }
+
 public:
+    typename FastSIMD::DispatchClass<DomainWarp, SIMD>::WarpKernel GetWarpKernel() const final
+    {
+        return FastSIMD::DispatchClass<DomainWarp, SIMD>::WarpKernel::Gradient;
+    }
+
     float32v FS_VECTORCALL Warp( int32v seed, float32v warpAmp, float32v x, float32v y, float32v& xOut, float32v& yOut ) const
     {
         seed += int32v( mSeedOffset );
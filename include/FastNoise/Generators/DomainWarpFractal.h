@@ -8,6 +8,18 @@ namespace FastNoise
     {
     public:
         const Metadata& GetMetadata() const override;
+
+        float EstimateCost( int dimensions ) const override
+        {
+            float cost = Generator::EstimateCost( dimensions ) + EstimateSourceCost( mGain, dimensions ) + EstimateSourceCost( mWeightedStrength, dimensions );
+
+            // Only the warp kernel runs per octave, the warp source and amplitude are generated once
+            if( mSource.base )
+            {
+                cost += mSource.base->EstimateCost( dimensions ) + mSource.base->Generator::EstimateCost( dimensions ) * (float)( mOctaves - 1 );
+            }
+            return cost;
+        }
     };
 
 #ifdef FASTNOISE_METADATA
@@ -34,6 +46,18 @@ namespace FastNoise
     {
     public:
         const Metadata& GetMetadata() const override;
+
+        float EstimateCost( int dimensions ) const override
+        {
+            float cost = Generator::EstimateCost( dimensions ) + EstimateSourceCost( mGain, dimensions ) + EstimateSourceCost( mWeightedStrength, dimensions );
+
+            // Only the warp kernel runs per octave, the warp source and amplitude are generated once
+            if( mSource.base )
+            {
+                cost += mSource.base->EstimateCost( dimensions ) + mSource.base->Generator::EstimateCost( dimensions ) * (float)( mOctaves - 1 );
+            }
+            return cost;
+        }
     };
 
 #ifdef FASTNOISE_METADATA
@@ -1,6 +1,54 @@
 #include "DomainWarpFractal.h"
 #include "Utils.inl"
 
+namespace FastNoise
+{
+    // Invokes func with a callable for the concrete kernel of the warp node
+    // Selected once per call so the fractal octave loop inlines the kernel instead of making a virtual call per octave
+    template<FastSIMD::FeatureSet SIMD, typename F>
+    FS_FORCEINLINE static auto DispatchWarpKernel( const FastSIMD::DispatchClass<DomainWarp, SIMD>* warp, F&& func )
+    {
+        using WarpKernel = typename FastSIMD::DispatchClass<DomainWarp, SIMD>::WarpKernel;
+        using Gradient = FastSIMD::DispatchClass<DomainWarpGradient, SIMD>;
+        using Simplex = FastSIMD::DispatchClass<DomainWarpSimplex, SIMD>;
+        using SuperSimplex = FastSIMD::DispatchClass<DomainWarpSuperSimplex, SIMD>;
+
+        switch( warp->GetWarpKernel() )
+        {
+        case WarpKernel::Gradient:
+            return func( [kernel = static_cast<const Gradient*>( warp )]( int32v seed, float32v warpAmp, auto&&... pos )
+            {
+                return kernel->Warp( seed, warpAmp, pos... );
+            } );
+        case WarpKernel::SimplexOrthogonalGradientMatrix:
+            return func( [kernel = static_cast<const Simplex*>( warp )]( int32v seed, float32v warpAmp, auto&&... pos )
+            {
+                return kernel->template WarpScheme<VectorizationScheme::OrthogonalGradientMatrix>( seed, warpAmp, pos... );
+            } );
+        case WarpKernel::SimplexGradientOuterProduct:
+            return func( [kernel = static_cast<const Simplex*>( warp )]( int32v seed, float32v warpAmp, auto&&... pos )
+            {
+                return kernel->template WarpScheme<VectorizationScheme::GradientOuterProduct>( seed, warpAmp, pos... );
+            } );
+        case WarpKernel::SuperSimplexOrthogonalGradientMatrix:
+            return func( [kernel = static_cast<const SuperSimplex*>( warp )]( int32v seed, float32v warpAmp, auto&&... pos )
+            {
+                return kernel->template WarpScheme<VectorizationScheme::OrthogonalGradientMatrix>( seed, warpAmp, pos... );
+            } );
+        case WarpKernel::SuperSimplexGradientOuterProduct:
+            return func( [kernel = static_cast<const SuperSimplex*>( warp )]( int32v seed, float32v warpAmp, auto&&... pos )
+            {
+                return kernel->template WarpScheme<VectorizationScheme::GradientOuterProduct>( seed, warpAmp, pos... );
+            } );
+        default:
+            return func( [warp]( int32v seed, float32v warpAmp, auto&&... pos )
+            {
+                return warp->Warp( seed, warpAmp, pos... );
+            } );
+        }
+    }
+}
+
 template<FastSIMD::FeatureSet SIMD>
 class FastSIMD::DispatchClass<DomainWarpFractalProgressive, SIMD> final : public virtual DomainWarpFractalProgressive, public DispatchClass<Fractal<DomainWarp>, SIMD>
 {
@@ -11,25 +59,38 @@ class FastSIMD::DispatchClass<DomainWarpFractalProgressive, SIMD> final : public
     {
         auto* warp = this->GetSourceSIMD( mSource );
 
-        float32v amp = this->GetSourceValue( warp->GetWarpAmplitude(), seed, pos... );
-        float32v weightedStrength = this->GetSourceValue( mWeightedStrength, seed, pos... );
-        float32v freq = float32v( warp->GetWarpFrequency() );
-        int32v seedInc = seed;
+        DispatchWarpKernel( warp, [&]( auto warpKernel )
+        {
+            float32v amp = this->GetSourceValue( warp->GetWarpAmplitude(), seed, pos... );
+            float32v weightedStrength = this->GetSourceValue( mWeightedStrength, seed, pos... );
+            float32v freq = float32v( warp->GetWarpFrequency() );
+            int32v seedInc = seed;
 
-        float32v gain = this->GetSourceValue( mGain, seed, pos... );
-        float32v lacunarity( mLacunarity );
+            float32v gain = this->GetSourceValue( mGain, seed, pos... );
+            float32v lacunarity( mLacunarity );
 
-        float32v strength = warp->Warp( seedInc, amp, (pos * freq)..., pos... );
+            float32v strength = warpKernel( seedInc, amp, (pos * freq)..., pos... );
 
-        for (int i = 1; i < mOctaves; i++)
-        {
-            strength = FastLengthSqrt( strength );
-            seedInc -= int32v( -1 );
-            freq *= lacunarity;
-            amp *= Lerp( float32v( 1 ), float32v( 1 ) - strength, weightedStrength );
-            amp *= gain;
-            strength = warp->Warp( seedInc, amp, (pos * freq)..., pos... );
-        }
+            float lodOctaveCount = this->GetLodOctaveCount();
+            int octaveCount = (int)std::ceil( lodOctaveCount );
+
+            for (int i = 1; i < octaveCount; i++)
+            {
+                strength = FastLengthSqrt( strength );
+                seedInc -= int32v( -1 );
+                freq *= lacunarity;
+                amp *= Lerp( float32v( 1 ), float32v( 1 ) - strength, weightedStrength );
+                amp *= gain;
+
+                float32v octaveAmp = amp;
+                if( !this->ApplyLodOctaveWeight( i, lodOctaveCount, gain, octaveAmp ) )
+                {
+                    break;
+                }
+
+                strength = warpKernel( seedInc, octaveAmp, (pos * freq)..., pos... );
+            }
+        } );
 
         return this->GetSourceValue( warp->GetWarpSource(), seed, pos... );
     }
@@ -47,25 +108,38 @@ class FastSIMD::DispatchClass<DomainWarpFractalIndependent, SIMD> final : public
         {
             auto* warp = this->GetSourceSIMD( mSource );
 
-            float32v amp = this->GetSourceValue( warp->GetWarpAmplitude(), seed, noisePos... );
-            float32v weightedStrength = this->GetSourceValue( mWeightedStrength, seed, noisePos... );
-            float32v freq = float32v( warp->GetWarpFrequency() );
-            int32v seedInc = seed;
-
-            float32v gain = this->GetSourceValue( mGain, seed, noisePos... );
-            float32v lacunarity( mLacunarity );
-        
-            float32v strength = warp->Warp( seedInc, amp, (noisePos * freq)..., warpPos... );
-    
-            for( int i = 1; i < mOctaves; i++ )
+            DispatchWarpKernel( warp, [&]( auto warpKernel )
             {
-                strength = FastLengthSqrt( strength );
-                seedInc -= int32v( -1 );
-                freq *= lacunarity;
-                amp *= Lerp( float32v( 1 ), float32v( 1 ) - strength, weightedStrength );
-                amp *= gain;
-                strength = warp->Warp( seedInc, amp, (noisePos * freq)..., warpPos... );
-            }
+                float32v amp = this->GetSourceValue( warp->GetWarpAmplitude(), seed, noisePos... );
+                float32v weightedStrength = this->GetSourceValue( mWeightedStrength, seed, noisePos... );
+                float32v freq = float32v( warp->GetWarpFrequency() );
+                int32v seedInc = seed;
+
+                float32v gain = this->GetSourceValue( mGain, seed, noisePos... );
+                float32v lacunarity( mLacunarity );
+
+                float32v strength = warpKernel( seedInc, amp, (noisePos * freq)..., warpPos... );
+
+                float lodOctaveCount = this->GetLodOctaveCount();
+                int octaveCount = (int)std::ceil( lodOctaveCount );
+
+                for( int i = 1; i < octaveCount; i++ )
+                {
+                    strength = FastLengthSqrt( strength );
+                    seedInc -= int32v( -1 );
+                    freq *= lacunarity;
+                    amp *= Lerp( float32v( 1 ), float32v( 1 ) - strength, weightedStrength );
+                    amp *= gain;
+
+                    float32v octaveAmp = amp;
+                    if( !this->ApplyLodOctaveWeight( i, lodOctaveCount, gain, octaveAmp ) )
+                    {
+                        break;
+                    }
+
+                    strength = warpKernel( seedInc, octaveAmp, (noisePos * freq)..., warpPos... );
+                }
+            } );
     
             return this->GetSourceValue( warp->GetWarpSource(), seed, warpPos... );
 
@@ -727,7 +727,41 @@ namespace FastNoise
 template<FastSIMD::FeatureSet SIMD>
 class FastSIMD::DispatchClass<DomainWarpSimplex, SIMD> final : public virtual DomainWarpSimplex, public DispatchClass<DomainWarp, SIMD>
 {
+    FASTNOISE_IMPL_GEN_T;
+
+    template<typename... P>
+    FS_FORCEINLINE float32v GenT( int32v seed, P... pos ) const
+    {
+        return this->GenWarpT( this, seed, pos... );
+    }
+
 public:
+    typename FastSIMD::DispatchClass<DomainWarp, SIMD>::WarpKernel GetWarpKernel() const final
+    {
+        using WarpKernel = typename FastSIMD::DispatchClass<DomainWarp, SIMD>::WarpKernel;
+
+        return mVectorizationScheme == VectorizationScheme::GradientOuterProduct ? WarpKernel::SimplexGradientOuterProduct : WarpKernel::SimplexOrthogonalGradientMatrix;
+    }
+
+    // Warp with the vectorization scheme known at compile time
+    template<VectorizationScheme Scheme, typename... P>
+    FS_FORCEINLINE float32v WarpScheme( int32v seed, float32v warpAmp, P&&... pos ) const
+    {
+        seed += int32v( mSeedOffset );
+        if constexpr( sizeof...( P ) == 4 )
+        {
+            return Warp_2D<Scheme>( seed, warpAmp, pos... );
+        }
+        else if constexpr( sizeof...( P ) == 6 )
+        {
+            return Warp_3D<Scheme>( seed, warpAmp, pos... );
+        }
+        else
+        {
+            return Warp_4D<Scheme>( seed, warpAmp, pos... );
+        }
+    }
+
     float32v FS_VECTORCALL Warp( int32v seed, float32v warpAmp, float32v x, float32v y, float32v& xOut, float32v& yOut ) const final
     {
         seed += int32v( mSeedOffset );
@@ -1090,7 +1124,40 @@ protected:
 template<FastSIMD::FeatureSet SIMD>
 class FastSIMD::DispatchClass<DomainWarpSuperSimplex, SIMD> final : public virtual DomainWarpSuperSimplex, public DispatchClass<DomainWarp, SIMD>
 {
+    FASTNOISE_IMPL_GEN_T;
+
+    template<typename... P>
+    FS_FORCEINLINE float32v GenT( int32v seed, P... pos ) const
+    {
+        return this->GenWarpT( this, seed, pos... );
+    }
+
 public:
+    typename FastSIMD::DispatchClass<DomainWarp, SIMD>::WarpKernel GetWarpKernel() const final
+    {
+        using WarpKernel = typename FastSIMD::DispatchClass<DomainWarp, SIMD>::WarpKernel;
+
+        return mVectorizationScheme == VectorizationScheme::GradientOuterProduct ? WarpKernel::SuperSimplexGradientOuterProduct : WarpKernel::SuperSimplexOrthogonalGradientMatrix;
+    }
+
+    // Warp with the vectorization scheme known at compile time
+    template<VectorizationScheme Scheme, typename... P>
+    FS_FORCEINLINE float32v WarpScheme( int32v seed, float32v warpAmp, P&&... pos ) const
+    {
+        if constexpr( sizeof...( P ) == 4 )
+        {
+            return Warp_2D<Scheme>( seed, warpAmp, pos... );
+        }
+        else if constexpr( sizeof...( P ) == 6 )
+        {
+            return Warp_3D<Scheme>( seed, warpAmp, pos... );
+        }
+        else
+        {
+            return Warp_4D<Scheme>( seed, warpAmp, pos... );
+        }
+    }
+
     float32v FS_VECTORCALL Warp( int32v seed, float32v warpAmp, float32v x, float32v y, float32v& xOut, float32v& yOut ) const final
     {
         switch( mVectorizationScheme )
@@ -13,7 +13,25 @@ namespace FastNoise
         void SetWeightedStrength( float value ) { mWeightedStrength = value; } 
         void SetWeightedStrength( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mWeightedStrength, gen ); }
         void SetOctaveCount( int value ) { mOctaves = value; }
-        void SetLacunarity( float value ) { mLacunarity = value; } 
+        void SetLacunarity( float value )
+        {
+            mLacunarity = value;
+            mLog2Lacunarity = value > 1.0f ? std::log2( value ) : 0.0f;
+            mInvLog2Lacunarity = value > 1.0f ? 1.0f / mLog2Lacunarity : 0.0f;
+        }
+        void SetLodFeatureScale( float value )
+        {
+            mLodFeatureScale = value;
+            mLog2LodNyquistScale = value > 0.0f ? std::log2( value * 0.5f ) : 0.0f;
+        }
+        void SetLodAmplitudeCutoff( float value ) { mLodAmplitudeCutoff = value; }
+
+        float EstimateCost( int dimensions ) const override
+        {
+            // Source is generated once per octave
+            return Generator::EstimateCost( dimensions ) + this->EstimateSourceCost( mGain, dimensions ) + this->EstimateSourceCost( mWeightedStrength, dimensions ) +
+                this->EstimateSourceCost( mSource, dimensions ) * (float)mOctaves;
+        }
 
     protected:
         GeneratorSourceT<T> mSource;
@@ -22,6 +40,13 @@ namespace FastNoise
 
         int   mOctaves = 3;
         float mLacunarity = 2.0f;
+        float mLodFeatureScale = 0.0f;
+        float mLodAmplitudeCutoff = 0.0f;
+
+        // Precomputed in the setters so LOD octave counts need no log2 per vector
+        float mLog2Lacunarity = 1.0f;
+        float mInvLog2Lacunarity = 1.0f;
+        float mLog2LodNyquistScale = 0.0f;
     };
 
 #ifdef FASTNOISE_METADATA
@@ -58,6 +83,20 @@ namespace FastNoise
                 "2.0 = Each octave is twice as detailed as the previous\n"
                 "Higher values create more contrast between large and small features" },
                 2.0f, &Fractal<T>::SetLacunarity );
+
+            this->AddVariable( { "LOD Feature Scale",
+                "Feature scale of the first octave in world units, used to skip octaves finer than the sample spacing\n"
+                "Octaves with a wavelength below 2 samples only add aliasing, the final octave is faded out smoothly\n"
+                "Only applies to GenUniformGrid*Lod() calls with a LOD quality above 0, where the sample spacing is known\n"
+                "0 = Disabled" },
+                0.0f, &Fractal<T>::SetLodFeatureScale, 0.0f, 0.0f, 0.25f );
+
+            this->AddVariable( { "LOD Amplitude Cutoff",
+                "Octaves with an amplitude below this value are skipped\n"
+                "Octaves within 2x the cutoff are faded out smoothly\n"
+                "Assumes Gain and Weighted Strength are in the 0-1 range\n"
+                "0 = Disabled" },
+                0.0f, &Fractal<T>::SetLodAmplitudeCutoff, 0.0f );
         }
     };
 #endif
@@ -3,7 +3,48 @@
 template<FastSIMD::FeatureSet SIMD, typename T>
 class FastSIMD::DispatchClass<Fractal<T>, SIMD> : public virtual Fractal<T>, public DispatchClass<Generator, SIMD>
 {
+protected:
+    // Number of octaves worth generating at the sample spacing of the active generation call
+    // Octaves with a wavelength below 2 samples are culled (Nyquist limit)
+    // Fractional part is the fade weight for the final octave
+    FS_FORCEINLINE float GetLodOctaveCount() const
+    {
+        if( this->mLodFeatureScale <= 0.0f || this->mLacunarity <= 1.0f || !( this->GetSampleFootprint() > 0.0f ) )
+        {
+            return (float)this->mOctaves;
+        }
+
+        // log2( featureScale / ( footprint * 2 ) ) / log2( lacunarity ), from values precomputed per setter and per generation call
+        float octaveCount = ( this->mLog2LodNyquistScale - this->GetSampleFootprintLog2() ) * this->mInvLog2Lacunarity;
+
+        return std::min( std::max( octaveCount, 1.0f ), (float)this->mOctaves );
+    }
+
+    // Applies the LOD fade weights to an octave's amplitude
+    // Returns false if all remaining octaves can be skipped
+    FS_FORCEINLINE bool ApplyLodOctaveWeight( int octave, float lodOctaveCount, float32v gain, float32v& amp ) const
+    {
+        if( this->mLodAmplitudeCutoff > 0.0f )
+        {
+            float32v cutoffWeight = FS::Abs( amp ) * float32v( 1.0f / this->mLodAmplitudeCutoff ) - float32v( 1 );
+            cutoffWeight = FS::Max( float32v( 0 ), FS::Min( float32v( 1 ), cutoffWeight ) );
+
+            // Amplitude only decreases from here if gain <= 1
+            if( !FS::AnyMask( cutoffWeight != float32v( 0 ) ) && !FS::AnyMask( gain > float32v( 1 ) ) )
+            {
+                return false;
+            }
 
+            amp *= cutoffWeight;
+        }
+
+        if( (float)( octave + 1 ) > lodOctaveCount )
+        {
+            amp *= float32v( lodOctaveCount - (float)octave );
+        }
+
+        return true;
+    }
 };
 
 template<FastSIMD::FeatureSet SIMD>
@@ -22,14 +63,25 @@ class FastSIMD::DispatchClass<FractalFBm, SIMD> final : public virtual FractalFB
 
         float32v sum = noise * amp;
 
-        for( int i = 1; i < mOctaves; i++ )
+        float lodOctaveCount = this->GetLodOctaveCount();
+        int octaveCount = (int)std::ceil( lodOctaveCount );
+        auto footprint = this->ScaleSampleFootprint();
+
+        for( int i = 1; i < octaveCount; i++ )
         {
             seed -= int32v( -1 );
             amp *= Lerp( float32v( 1 ), (noise + float32v( 1 )) * float32v( 0.5f ), weightedStrength );
             amp *= gain;
 
+            float32v octaveAmp = amp;
+            if( !this->ApplyLodOctaveWeight( i, lodOctaveCount, gain, octaveAmp ) )
+            {
+                break;
+            }
+
+            footprint.Scale( mLacunarity, mLog2Lacunarity );
             noise = this->GetSourceValue( mSource, seed, (pos *= lacunarity)... );
-            sum += noise * amp;
+            sum += noise * octaveAmp;
         }
 
         return sum;
@@ -52,14 +104,25 @@ class FastSIMD::DispatchClass<FractalRidged, SIMD> final : public virtual Fracta
 
         float32v sum = (noise * float32v( -2 ) + float32v( 1 )) * amp;
 
-        for( int i = 1; i < mOctaves; i++ )
+        float lodOctaveCount = this->GetLodOctaveCount();
+        int octaveCount = (int)std::ceil( lodOctaveCount );
+        auto footprint = this->ScaleSampleFootprint();
+
+        for( int i = 1; i < octaveCount; i++ )
         {
             seed -= int32v( -1 );
             amp *= Lerp( float32v( 1 ), float32v( 1 ) - noise, weightedStrength );
             amp *= gain;
 
+            float32v octaveAmp = amp;
+            if( !this->ApplyLodOctaveWeight( i, lodOctaveCount, gain, octaveAmp ) )
+            {
+                break;
+            }
+
+            footprint.Scale( mLacunarity, mLog2Lacunarity );
             noise = FS::Abs( this->GetSourceValue( mSource, seed, (pos *= lacunarity)... ) );
-            sum += (noise * float32v( -2 ) + float32v( 1 )) * amp;
+            sum += (noise * float32v( -2 ) + float32v( 1 )) * octaveAmp;
         }
 
         return sum;
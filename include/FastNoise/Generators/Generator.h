@@ -6,6 +6,9 @@
 
 #ifdef FASTNOISE_METADATA
 #include <tuple>
+#include <typeinfo>
+#include <cstdint>
+#include <mutex>
 #endif
 
 #include "FastNoise/Utility/Config.h"
@@ -152,6 +155,9 @@ namespace FastNoise
         void BumpNodeRefences( const Generator*, bool );
     }
 
+    template<typename T>
+    struct PerDimensionVariable;
+
     /** @brief Abstract base class for all FastNoise2 noise generator nodes.
      *
      *  Generator is the root of the node class hierarchy. All noise types (Simplex, Perlin,
@@ -428,7 +434,79 @@ namespace FastNoise
          */
         virtual float GenSingle4D( float x, float y, float z, float w, int seed ) const = 0;
 
+        /** @brief Estimate the cost of generating noise with this node tree.
+         *
+         *  Sums the estimated per sample cost of every node in the tree for the active SIMD feature set,
+         *  including sources that are generated multiple times such as fractal octaves.
+         *  Useful for sizing work units and balancing load when scheduling generation across threads.
+         *
+         *  Multiply by the number of samples to estimate the time for a generation call.
+         *  GenTileable2D() generates in 4D.
+         *
+         *  @param dimensions  Number of generated dimensions: 2, 3 or 4.
+         *  @return Estimated nanoseconds per sample, 0 if @p dimensions is out of range.
+         *          The shipped cost table is uncalibrated, so only compare estimates with each other.
+         *  @see Metadata::GetSampleCost
+         */
+        virtual float EstimateCost( int dimensions ) const;
+
+        /** @brief Generate a 2D uniform grid of noise values with a level of detail budget.
+         *
+         *  Same as GenUniformGrid2D(), with the sample spacing made available to nodes that can approximate
+         *  detail finer than it, such as fractal octave culling (LOD Feature Scale) and domain warp fading.
+         *
+         *  @param      lodQuality Level of detail budget. 0 gives the same output as GenUniformGrid2D().
+         *                         Values above 0 allow nodes to use cheaper approximations for detail finer than
+         *                         `stepSize / lodQuality`, 1 = cull detail beyond the sample resolution,
+         *                         lower values cull more aggressively.
+         *  @see GenUniformGrid2D
+         */
+        virtual OutputMinMax GenUniformGrid2DLod( float* out,
+            float xOffset,   float yOffset,
+              int xCount,      int yCount,
+            float xStepSize, float yStepSize,
+            int seed, float lodQuality ) const = 0;
+
+        /** @brief Generate a 3D uniform grid of noise values with a level of detail budget.
+         *
+         *  @param      lodQuality Level of detail budget, see GenUniformGrid2DLod().
+         *  @see GenUniformGrid3D
+         */
+        virtual OutputMinMax GenUniformGrid3DLod( float* out,
+            float xOffset,   float yOffset,   float zOffset,
+              int xCount,      int yCount,      int zCount,
+            float xStepSize, float yStepSize, float zStepSize,
+            int seed, float lodQuality ) const = 0;
+
+        /** @brief Generate a 4D uniform grid of noise values with a level of detail budget.
+         *
+         *  @param      lodQuality Level of detail budget, see GenUniformGrid2DLod().
+         *  @see GenUniformGrid4D
+         */
+        virtual OutputMinMax GenUniformGrid4DLod( float* out,
+            float xOffset,   float yOffset,   float zOffset,   float wOffset,
+              int xCount,      int yCount,      int zCount,      int wCount,
+            float xStepSize, float yStepSize, float zStepSize, float wStepSize,
+            int seed, float lodQuality ) const = 0;
+
     protected:
+        template<typename T>
+        static float EstimateSourceCost( const BaseSource<T>& source, int dimensions )
+        {
+            return source.base ? source.base->EstimateCost( dimensions ) : 0.0f;
+        }
+
+        template<typename T>
+        static float EstimatePerDimensionSourceCost( const PerDimensionVariable<T>& sources, int dimensions )
+        {
+            float cost = 0.0f;
+            for( int i = 0; i < std::min( dimensions, (int)Dim::Count ); i++ )
+            {
+                cost += EstimateSourceCost( sources[i], dimensions );
+            }
+            return cost;
+        }
+
         template<typename T>
         void SetSourceMemberVariable( BaseSource<T>& memberVariable, SmartNodeArg<T> gen )
         {
@@ -491,6 +569,87 @@ namespace FastNoise
     };
 
 #ifdef FASTNOISE_METADATA
+    namespace Impl
+    {
+        /** @brief Cast a node to the class that declares a metadata member.
+         *
+         *  Equivalent to dynamic_cast, the cast is resolved once per concrete node type and stored in the
+         *  Metadata's MemberCastTable for the declaring class. Later casts apply the stored pointer offset,
+         *  which removes the RTTI hierarchy walk from deserialisation.
+         */
+        template<typename U>
+        U* MemberCast( const Metadata::MemberCastTable* table, Generator* g )
+        {
+            if constexpr( std::is_same_v<U, Generator> )
+            {
+                return g;
+            }
+            else
+            {
+                if( !g )
+                {
+                    return nullptr;
+                }
+
+                const std::type_info* type = &typeid( *g );
+
+                for( size_t i = 0; i < Metadata::MemberCastTable::kCapacity; i++ )
+                {
+                    const std::type_info* entryType = table->nodeTypes[i].load( std::memory_order_acquire );
+
+                    if( entryType == type )
+                    {
+                        return reinterpret_cast<U*>( reinterpret_cast<char*>( g ) + table->offsets[i] );
+                    }
+                    if( !entryType )
+                    {
+                        break;
+                    }
+                }
+
+                U* cast = dynamic_cast<U*>( g );
+
+                if( cast )
+                {
+                    static std::mutex sInsertMutex;
+                    std::lock_guard<std::mutex> lock( sInsertMutex );
+                    auto* mutableTable = const_cast<Metadata::MemberCastTable*>( table );
+
+                    for( size_t i = 0; i < Metadata::MemberCastTable::kCapacity; i++ )
+                    {
+                        const std::type_info* entryType = mutableTable->nodeTypes[i].load( std::memory_order_relaxed );
+
+                        if( entryType == type )
+                        {
+                            break;
+                        }
+                        if( !entryType )
+                        {
+                            mutableTable->offsets[i] = reinterpret_cast<char*>( cast ) - reinterpret_cast<char*>( g );
+                            mutableTable->nodeTypes[i].store( type, std::memory_order_release );
+                            break;
+                        }
+                    }
+                }
+                return cast;
+            }
+        }
+
+        // Source nodes are almost always set as Generator, other source types use dynamic_cast
+        template<typename T>
+        const T* SourceCast( const Generator* s )
+        {
+            if constexpr( std::is_same_v<T, Generator> )
+            {
+                return s;
+            }
+            else
+            {
+                return dynamic_cast<const T*>( s );
+            }
+        }
+    }
+
     template<>
     struct MetadataT<Generator> : Metadata
     {
@@ -508,9 +667,11 @@ namespace FastNoise
 
             member.type = std::is_same_v<T, float> ? MemberVariable::EFloat : MemberVariable::EInt;
 
-            member.setFunc = [func]( Generator* g, MemberVariable::ValueUnion v )
+            const MemberCastTable* castTable = GetMemberCastTable<std::remove_pointer_t<GetArg<U, 0>>>();
+
+            member.setFunc = [func, castTable]( Generator* g, MemberVariable::ValueUnion v )
             {
-                if( auto* gRealType = dynamic_cast<GetArg<U, 0>>( g ) )
+                if( auto* gRealType = Impl::MemberCast<std::remove_pointer_t<GetArg<U, 0>>>( castTable, g ) )
                 {
                     func( gRealType, v );
                     return true;
@@ -534,9 +695,11 @@ namespace FastNoise
 
             member.type = std::is_same_v<T, float> ? MemberVariable::EFloat : MemberVariable::EInt;
 
-            member.setFunc = [func]( Generator* g, MemberVariable::ValueUnion v )
+            const MemberCastTable* castTable = GetMemberCastTable<U>();
+
+            member.setFunc = [func, castTable]( Generator* g, MemberVariable::ValueUnion v )
             {
-                if( U* gRealType = dynamic_cast<U*>( g ) )
+                if( U* gRealType = Impl::MemberCast<U>( castTable, g ) )
                 {
                     (gRealType->*func)( v );
                     return true;
@@ -557,9 +720,11 @@ namespace FastNoise
             member.valueDefault = (int)defaultV;
             ( member.enumNames.push_back( enumNames ), ... );
 
-            member.setFunc = [func]( Generator* g, MemberVariable::ValueUnion v )
+            const MemberCastTable* castTable = GetMemberCastTable<U>();
+
+            member.setFunc = [func, castTable]( Generator* g, MemberVariable::ValueUnion v )
             {
-                if( U* gRealType = dynamic_cast<U*>( g ) )
+                if( U* gRealType = Impl::MemberCast<U>( castTable, g ) )
                 {
                     (gRealType->*func)( (T)v.i );
                     return true;
@@ -583,9 +748,11 @@ namespace FastNoise
                 member.enumNames.push_back( enumName );
             }
 
-            member.setFunc = [func]( Generator* g, MemberVariable::ValueUnion v )
+            const MemberCastTable* castTable = GetMemberCastTable<U>();
+
+            member.setFunc = [func, castTable]( Generator* g, MemberVariable::ValueUnion v )
             {
-                if( U* gRealType = dynamic_cast<U*>( g ) )
+                if( U* gRealType = Impl::MemberCast<U>( castTable, g ) )
                 {
                     (gRealType->*func)( (T)v.i );
                     return true;
@@ -599,6 +766,8 @@ namespace FastNoise
         template<typename T, typename U, typename = std::enable_if_t<!std::is_enum_v<T>>>
         void AddPerDimensionVariable( NameDesc nameDesc, T defaultV, U&& func, T minV = 0, T maxV = 0, float uiDragSpeed = std::is_same_v<T, float> ? Metadata::kDefaultUiDragSpeedFloat : Metadata::kDefaultUiDragSpeedInt )
         {
+            const MemberCastTable* castTable = GetMemberCastTable<std::remove_pointer_t<GetArg<U, 0>>>();
+
             for( int idx = 0; (size_t)idx < (size_t)Dim::Count; idx++ )
             {
                 MemberVariable member;
@@ -612,9 +781,9 @@ namespace FastNoise
                 member.type = std::is_same_v<T, float> ? MemberVariable::EFloat : MemberVariable::EInt;
                 member.dimensionIdx = idx;
 
-                member.setFunc = [func, idx]( Generator* g, MemberVariable::ValueUnion v )
+                member.setFunc = [func, idx, castTable]( Generator* g, MemberVariable::ValueUnion v )
                 {
-                    if( auto* gRealType = dynamic_cast<GetArg<U, 0>>( g ) )
+                    if( auto* gRealType = Impl::MemberCast<std::remove_pointer_t<GetArg<U, 0>>>( castTable, g ) )
                     {
                         func( gRealType ).get()[idx] = v;
                         return true;
@@ -633,11 +802,13 @@ namespace FastNoise
             member.name = nameDesc.name;
             member.description = nameDesc.desc;
 
-            member.setFunc = [func]( Generator* g, SmartNodeArg<> s )
+            const MemberCastTable* castTable = GetMemberCastTable<U>();
+
+            member.setFunc = [func, castTable]( Generator* g, SmartNodeArg<> s )
             {
-                if( const T* sUpCast = dynamic_cast<const T*>( s.get() ) )
+                if( const T* sUpCast = Impl::SourceCast<T>( s.get() ) )
                 {
-                    if( U* gRealType = dynamic_cast<U*>( g ) )
+                    if( U* gRealType = Impl::MemberCast<U>( castTable, g ) )
                     {
                         SmartNode<const T> source( s, sUpCast ); 
                         (gRealType->*func)( source );
@@ -656,6 +827,8 @@ namespace FastNoise
             using GeneratorSourceT = typename std::invoke_result_t<U, GetArg<U, 0>>::type::Type;
             using T = typename GeneratorSourceT::Type;
 
+            const MemberCastTable* castTable = GetMemberCastTable<std::remove_pointer_t<GetArg<U, 0>>>();
+
             for( int idx = 0; (size_t)idx < (size_t)Dim::Count; idx++ )
             {
                 MemberNodeLookup member;
@@ -663,11 +836,11 @@ namespace FastNoise
                 member.description = nameDesc.desc;
                 member.dimensionIdx = idx;
 
-                member.setFunc = [func, idx]( Generator* g, SmartNodeArg<> s )
+                member.setFunc = [func, idx, castTable]( Generator* g, SmartNodeArg<> s )
                 {
-                    if( const T* sUpCast = dynamic_cast<const T*>( s.get() ) )
+                    if( const T* sUpCast = Impl::SourceCast<T>( s.get() ) )
                     {
-                        if( auto* gRealType = dynamic_cast<GetArg<U, 0>>( g ) )
+                        if( auto* gRealType = Impl::MemberCast<std::remove_pointer_t<GetArg<U, 0>>>( castTable, g ) )
                         {
                             SmartNode<const T> source( s, sUpCast ); 
                             g->SetSourceMemberVariable( func( gRealType ).get()[idx], source );
@@ -691,11 +864,13 @@ namespace FastNoise
             member.valueDefault = defaultValue;
             member.valueUiDragSpeed = uiDragSpeed;
 
-            member.setNodeFunc = [funcNode]( Generator* g, SmartNodeArg<> s )
+            const MemberCastTable* castTable = GetMemberCastTable<U>();
+
+            member.setNodeFunc = [funcNode, castTable]( Generator* g, SmartNodeArg<> s )
             {
-                if( const T* sUpCast = dynamic_cast<const T*>( s.get() ) )
+                if( const T* sUpCast = Impl::SourceCast<T>( s.get() ) )
                 {
-                    if( U* gRealType = dynamic_cast<U*>( g ) )
+                    if( U* gRealType = Impl::MemberCast<U>( castTable, g ) )
                     {
                         SmartNode<const T> source( s, sUpCast ); 
                         (gRealType->*funcNode)( source );
@@ -705,9 +880,9 @@ namespace FastNoise
                 return false;
             };
 
-            member.setValueFunc = [funcValue]( Generator* g, float v )
+            member.setValueFunc = [funcValue, castTable]( Generator* g, float v )
             {
-                if( U* gRealType = dynamic_cast<U*>( g ) )
+                if( U* gRealType = Impl::MemberCast<U>( castTable, g ) )
                 {
                     (gRealType->*funcValue)( v );
                     return true;
@@ -724,6 +899,8 @@ namespace FastNoise
             using HybridSourceT = typename std::invoke_result_t<U, GetArg<U, 0>>::type::Type;
             using T = typename HybridSourceT::Type;
 
+            const MemberCastTable* castTable = GetMemberCastTable<std::remove_pointer_t<GetArg<U, 0>>>();
+
             for( int idx = 0; (size_t)idx < (size_t)Dim::Count; idx++ )
             {
                 MemberHybrid member;
@@ -733,11 +910,11 @@ namespace FastNoise
                 member.valueUiDragSpeed = uiDragSpeed;
                 member.dimensionIdx = idx;
 
-                member.setNodeFunc = [func, idx]( Generator* g, SmartNodeArg<> s )
+                member.setNodeFunc = [func, idx, castTable]( Generator* g, SmartNodeArg<> s )
                 {
-                    if( const T* sUpCast = dynamic_cast<const T*>( s.get() ) )
+                    if( const T* sUpCast = Impl::SourceCast<T>( s.get() ) )
                     {
-                        if( auto* gRealType = dynamic_cast<GetArg<U, 0>>( g ) )
+                        if( auto* gRealType = Impl::MemberCast<std::remove_pointer_t<GetArg<U, 0>>>( castTable, g ) )
                         {
                             SmartNode<const T> source( s, sUpCast ); 
                             g->SetSourceMemberVariable( func( gRealType ).get()[idx], source );
@@ -747,9 +924,9 @@ namespace FastNoise
                     return false;
                 };
 
-                member.setValueFunc = [func, idx]( Generator* g, float v )
+                member.setValueFunc = [func, idx, castTable]( Generator* g, float v )
                 {
-                    if( auto* gRealType = dynamic_cast<GetArg<U, 0>>( g ) )
+                    if( auto* gRealType = Impl::MemberCast<std::remove_pointer_t<GetArg<U, 0>>>( castTable, g ) )
                     {
                         func( gRealType ).get()[idx] = v;
                         return true;
@@ -762,6 +939,20 @@ namespace FastNoise
         }
 
     private:
+        // One cast table per class declaring members, created when the members are registered
+        template<typename U>
+        const MemberCastTable* GetMemberCastTable()
+        {
+            for( const auto& table : mMemberCastTables )
+            {
+                if( table->declaringType == &typeid( U ) )
+                {
+                    return table.get();
+                }
+            }
+            return mMemberCastTables.emplace_back( new MemberCastTable( &typeid( U ) ) ).get();
+        }
+
         template<typename F, typename Ret, typename... Args>
         static std::tuple<Args...> GetArg_Helper( Ret( F::* )(Args...) const );
 
@@ -1,8 +1,18 @@
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstring>
 
 #include "Generator.h"
 
+#if FASTNOISE_PROFILING
+#include "FastNoise/Utility/NodeProfiler.h"
+#endif
+
+#if FASTNOISE_TRACING
+#include "FastNoise/Utility/GenerationTracer.h"
+#endif
+
 #pragma warning( disable:4250 )
 
 using namespace FastNoise;
@@ -12,6 +22,52 @@ using float32v = FS::Register<float, kRegisterSize>;
 using int32v = FS::Register<std::int32_t, kRegisterSize>;
 using mask32v = typename float32v::MaskType;
 
+#if FASTNOISE_PROFILING
+// Times the enclosed node evaluation while a profiling session is active
+struct ScopeProfileNode
+{
+    FS_FORCEINLINE ScopeProfileNode( const Generator* node, size_t samples ) : active( NodeProfiler::EnterNode( node, samples ) ) {}
+
+    FS_FORCEINLINE ~ScopeProfileNode()
+    {
+        if( active )
+        {
+            NodeProfiler::ExitNode();
+        }
+    }
+
+    bool active;
+};
+
+#define FASTNOISE_PROFILE_NODE( NODE, SAMPLES ) ScopeProfileNode profileNode( NODE, SAMPLES )
+#else
+#define FASTNOISE_PROFILE_NODE( NODE, SAMPLES ) (void)0
+#endif
+
+#if FASTNOISE_TRACING
+// Updates generation call counters and runs tracing callbacks around a generation call
+struct ScopeTraceGeneration
+{
+    FS_FORCEINLINE ScopeTraceGeneration( const Generator* node, GenerationCallType type, size_t samples ) :
+        call{ node, type, samples }, startNs( GenerationTracer::BeginCall( call ) ) {}
+
+    FS_FORCEINLINE ~ScopeTraceGeneration()
+    {
+        if( startNs )
+        {
+            GenerationTracer::EndCall( call, startNs );
+        }
+    }
+
+    GenerationCallInfo call;
+    uint64_t startNs;
+};
+
+#define FASTNOISE_TRACE_GENERATION( TYPE, SAMPLES ) ScopeTraceGeneration traceGeneration( this, GenerationCallType::TYPE, SAMPLES )
+#else
+#define FASTNOISE_TRACE_GENERATION( TYPE, SAMPLES ) (void)0
+#endif
+
 template<FastSIMD::FeatureSet SIMD>
 class FastSIMD::DispatchClass<Generator, SIMD> : public virtual Generator
 {
@@ -32,7 +88,7 @@ public:
 
     using VoidPtrStorageType = const DispatchClass<Generator, SIMD>*;
 
-    void SetSourceSIMDPtr( const Generator* base, const void** simdPtr ) final
+    void SetSourceSIMDPtr( const Generator* base, const void** simdPtr ) override
     {
         if( !base )
         {
@@ -51,6 +107,7 @@ public:
         if( memberVariable.simdGeneratorPtr )
         {
             auto simdGen = reinterpret_cast<VoidPtrStorageType>( memberVariable.simdGeneratorPtr );
+            FASTNOISE_PROFILE_NODE( simdGen, float32v::ElementCount );
 
             return simdGen->Gen( seed, pos... );
         }
@@ -62,6 +119,7 @@ public:
     {
         assert( memberVariable.simdGeneratorPtr );
         auto simdGen = reinterpret_cast<VoidPtrStorageType>( memberVariable.simdGeneratorPtr );
+        FASTNOISE_PROFILE_NODE( simdGen, float32v::ElementCount );
 
         return simdGen->Gen( seed, pos... );
     }
@@ -76,9 +134,88 @@ public:
         return simdT;
     }
 
+    // Distance between neighbouring samples in this node's input space for the active generation call on this thread
+    // Divided by the requested LOD quality, 0 if LOD is not enabled for this call (quality 0, position arrays, single samples)
+    static FS_FORCEINLINE float GetSampleFootprint()
+    {
+        return tLodState.footprint;
+    }
+
+    // log2 of GetSampleFootprint(), only valid if the footprint is above 0
+    static FS_FORCEINLINE float GetSampleFootprintLog2()
+    {
+        return tLodState.log2Footprint;
+    }
+
+    // True if the caller requested a LOD quality, allowing nodes to approximate sub-footprint detail
+    static FS_FORCEINLINE bool IsLodApproximationEnabled()
+    {
+        return GetSampleFootprint() > 0.0f;
+    }
+
+    // Scales the sample footprint seen by source nodes to match positions scaled by this node
+    // Restores the previous footprint on exit
+    struct ScopeSampleFootprintScale
+    {
+        FS_FORCEINLINE ScopeSampleFootprintScale() : previous( GetSampleFootprint() ), previousLog2( previous != 0.0f ? tLodState.log2Footprint : 0.0f ) {}
+
+        FS_FORCEINLINE ScopeSampleFootprintScale( float scale ) : ScopeSampleFootprintScale()
+        {
+            Scale( scale );
+        }
+
+        FS_FORCEINLINE void Scale( float scale )
+        {
+            if( previous != 0.0f )
+            {
+                Scale( scale, std::log2( std::abs( scale ) ) );
+            }
+        }
+
+        // Avoids the log2 when the caller has it precomputed
+        FS_FORCEINLINE void Scale( float scale, float log2Scale )
+        {
+            if( previous != 0.0f )
+            {
+                tLodState.footprint *= std::abs( scale );
+                tLodState.log2Footprint += log2Scale;
+            }
+        }
+
+        FS_FORCEINLINE ~ScopeSampleFootprintScale()
+        {
+            if( previous != 0.0f )
+            {
+                tLodState.footprint = previous;
+                tLodState.log2Footprint = previousLog2;
+            }
+        }
+
+        float previous;
+        float previousLog2;
+    };
+
+    static FS_FORCEINLINE ScopeSampleFootprintScale ScaleSampleFootprint( float scale )
+    {
+        return ScopeSampleFootprintScale( scale );
+    }
+
+    static FS_FORCEINLINE ScopeSampleFootprintScale ScaleSampleFootprint()
+    {
+        return ScopeSampleFootprintScale();
+    }
+
     FastNoise::OutputMinMax GenUniformGrid2D( float* noiseOut, float xOffset, float yOffset, int xCount, int yCount, float xStepSize, float yStepSize, int seed ) const final
+    {
+        return DispatchClass::GenUniformGrid2DLod( noiseOut, xOffset, yOffset, xCount, yCount, xStepSize, yStepSize, seed, 0.0f );
+    }
+
+    FastNoise::OutputMinMax GenUniformGrid2DLod( float* noiseOut, float xOffset, float yOffset, int xCount, int yCount, float xStepSize, float yStepSize, int seed, float lodQuality ) const final
     {
         ScopeExitx86ZeroUpper zeroUpper;
+        FASTNOISE_TRACE_GENERATION( UniformGrid2D, (size_t)xCount * yCount );
+        FASTNOISE_PROFILE_NODE( this, (size_t)xCount * yCount );
+        ScopeSampleFootprint footprint( lodQuality, xStepSize, yStepSize );
         float32v min( kInfinity );
         float32v max( -kInfinity );
 
@@ -127,8 +264,16 @@ public:
     }
 
     FastNoise::OutputMinMax GenUniformGrid3D( float* noiseOut, float xOffset, float yOffset, float zOffset, int xCount, int yCount, int zCount, float xStepSize, float yStepSize, float zStepSize, int seed ) const final
+    {
+        return DispatchClass::GenUniformGrid3DLod( noiseOut, xOffset, yOffset, zOffset, xCount, yCount, zCount, xStepSize, yStepSize, zStepSize, seed, 0.0f );
+    }
+
+    FastNoise::OutputMinMax GenUniformGrid3DLod( float* noiseOut, float xOffset, float yOffset, float zOffset, int xCount, int yCount, int zCount, float xStepSize, float yStepSize, float zStepSize, int seed, float lodQuality ) const final
     {
         ScopeExitx86ZeroUpper zeroUpper;
+        FASTNOISE_TRACE_GENERATION( UniformGrid3D, (size_t)xCount * yCount * zCount );
+        FASTNOISE_PROFILE_NODE( this, (size_t)xCount * yCount * zCount );
+        ScopeSampleFootprint footprint( lodQuality, xStepSize, yStepSize, zStepSize );
         float32v min( kInfinity );
         float32v max( -kInfinity );
 
@@ -186,8 +331,16 @@ public:
     }
 
     FastNoise::OutputMinMax GenUniformGrid4D( float* noiseOut, float xOffset, float yOffset, float zOffset, float wOffset, int xCount, int yCount, int zCount, int wCount, float xStepSize, float yStepSize, float zStepSize, float wStepSize, int seed ) const final
+    {
+        return DispatchClass::GenUniformGrid4DLod( noiseOut, xOffset, yOffset, zOffset, wOffset, xCount, yCount, zCount, wCount, xStepSize, yStepSize, zStepSize, wStepSize, seed, 0.0f );
+    }
+
+    FastNoise::OutputMinMax GenUniformGrid4DLod( float* noiseOut, float xOffset, float yOffset, float zOffset, float wOffset, int xCount, int yCount, int zCount, int wCount, float xStepSize, float yStepSize, float zStepSize, float wStepSize, int seed, float lodQuality ) const final
     {
         ScopeExitx86ZeroUpper zeroUpper;
+        FASTNOISE_TRACE_GENERATION( UniformGrid4D, (size_t)xCount * yCount * zCount * wCount );
+        FASTNOISE_PROFILE_NODE( this, (size_t)xCount * yCount * zCount * wCount );
+        ScopeSampleFootprint footprint( lodQuality, xStepSize, yStepSize, zStepSize, wStepSize );
         float32v min( kInfinity );
         float32v max( -kInfinity );
 
@@ -256,6 +409,8 @@ public:
     FastNoise::OutputMinMax GenPositionArray2D( float* noiseOut, int count, const float* xPosArray, const float* yPosArray, float xOffset, float yOffset, int seed ) const final
     {
         ScopeExitx86ZeroUpper zeroUpper;
+        FASTNOISE_TRACE_GENERATION( PositionArray2D, (size_t)count );
+        FASTNOISE_PROFILE_NODE( this, (size_t)count );
         float32v min( kInfinity );
         float32v max( -kInfinity );
 
@@ -286,6 +441,8 @@ public:
     FastNoise::OutputMinMax GenPositionArray3D( float* noiseOut, int count, const float* xPosArray, const float* yPosArray, const float* zPosArray, float xOffset, float yOffset, float zOffset, int seed ) const final
     {
         ScopeExitx86ZeroUpper zeroUpper;
+        FASTNOISE_TRACE_GENERATION( PositionArray3D, (size_t)count );
+        FASTNOISE_PROFILE_NODE( this, (size_t)count );
         float32v min( kInfinity );
         float32v max( -kInfinity );
 
@@ -318,6 +475,8 @@ public:
     FastNoise::OutputMinMax GenPositionArray4D( float* noiseOut, int count, const float* xPosArray, const float* yPosArray, const float* zPosArray, const float* wPosArray, float xOffset, float yOffset, float zOffset, float wOffset, int seed ) const final
     {
         ScopeExitx86ZeroUpper zeroUpper;
+        FASTNOISE_TRACE_GENERATION( PositionArray4D, (size_t)count );
+        FASTNOISE_PROFILE_NODE( this, (size_t)count );
         float32v min( kInfinity );
         float32v max( -kInfinity );
 
@@ -352,24 +511,33 @@ public:
     float GenSingle2D( float x, float y, int seed ) const final
     {
         ScopeExitx86ZeroUpper zeroUpper;
+        FASTNOISE_TRACE_GENERATION( Single2D, 1 );
+        FASTNOISE_PROFILE_NODE( this, 1 );
         return FS::Extract0( Gen( int32v( seed ), float32v( x ), float32v( y ) ) );
     }
 
     float GenSingle3D( float x, float y, float z, int seed ) const final
     {
         ScopeExitx86ZeroUpper zeroUpper;
+        FASTNOISE_TRACE_GENERATION( Single3D, 1 );
+        FASTNOISE_PROFILE_NODE( this, 1 );
         return FS::Extract0( Gen( int32v( seed ), float32v( x ), float32v( y ), float32v( z ) ) );
     }
 
     float GenSingle4D( float x, float y, float z, float w, int seed ) const final
     {
         ScopeExitx86ZeroUpper zeroUpper;
+        FASTNOISE_TRACE_GENERATION( Single4D, 1 );
+        FASTNOISE_PROFILE_NODE( this, 1 );
         return FS::Extract0( Gen( int32v( seed ), float32v( x ), float32v( y ), float32v( z ), float32v( w ) ) );
     }
 
     FastNoise::OutputMinMax GenTileable2D( float* noiseOut, int xSize, int ySize, float xStepSize, float yStepSize, int seed ) const final
     {
         ScopeExitx86ZeroUpper zeroUpper;
+        FASTNOISE_TRACE_GENERATION( Tileable2D, (size_t)xSize * ySize );
+        FASTNOISE_PROFILE_NODE( this, (size_t)xSize * ySize );
+        ScopeSampleFootprint footprint( 0.0f, xStepSize, yStepSize );
         float32v min( kInfinity );
         float32v max( -kInfinity );
 
@@ -444,6 +612,45 @@ private:
         }
     };
 
+    struct LodState
+    {
+        float footprint;
+        float log2Footprint;
+    };
+
+    // Sets the LOD state for the duration of a generation call
+    // Restores the previous state on exit to handle nested generation calls
+    // log2 of the footprint is computed once here, nodes only add to it
+    // Calls with a quality of 0 only read the thread local state, and only write it when nested inside a LOD call on this thread
+    struct ScopeSampleFootprint
+    {
+        template<typename... S>
+        FS_FORCEINLINE ScopeSampleFootprint( float quality, S... stepSize ) : active( quality > 0.0f || tLodState.footprint != 0.0f )
+        {
+            if( active )
+            {
+                float footprint = quality > 0.0f ? std::max( { std::abs( stepSize )... } ) / quality : 0.0f;
+
+                previous = tLodState;
+                tLodState = { footprint, footprint > 0.0f ? std::log2( footprint ) : 0.0f };
+            }
+        }
+
+        FS_FORCEINLINE ~ScopeSampleFootprint()
+        {
+            if( active )
+            {
+                tLodState = previous;
+            }
+        }
+
+        LodState previous = {};
+        bool active;
+    };
+
+    // Footprint is 0 outside LOD generation calls on this thread, trivially destructible so it needs no TLS guard
+    static inline thread_local LodState tLodState = {};
+
     template<bool INITIAL>
     static FS_FORCEINLINE void AxisReset( int32v& aIdx, int32v& bIdx, int32v aMax, int32v aSize, size_t aStep )
     {
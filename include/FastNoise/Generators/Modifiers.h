@@ -11,6 +11,11 @@ namespace FastNoise
         void SetSource( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mSource, gen ); }
         void SetScaling( float value ) { mScale = value; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
         float mScale = 1.0f;
@@ -47,6 +52,11 @@ namespace FastNoise
         template<Dim D>
         void SetOffset( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mOffset[(int)D], gen ); }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions ) + EstimatePerDimensionSourceCost( mOffset, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
         PerDimensionVariable<HybridSource> mOffset = 0.0f;
@@ -85,6 +95,11 @@ namespace FastNoise
         void SetPitch( float value ) { mPitchCos = std::cos( value ); mPitchSin = std::sin( value ); CalculateRotation(); }
         void SetRoll(  float value ) { mRollCos  = std::cos( value ); mRollSin  = std::sin( value ); CalculateRotation(); }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
         float mYawCos   = 1.0f;
@@ -151,6 +166,11 @@ namespace FastNoise
         void SetSource( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mSource, gen ); }
         void SetOffset( int value ) { mOffset = value; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
         int mOffset = 1;
@@ -196,6 +216,11 @@ namespace FastNoise
         void SetClampOutput( Boolean value ) { mClampOutput = value; }
         void SetClampOutput( bool value ) { mClampOutput = value ? Boolean::True : Boolean::False; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions ) + EstimateSourceCost( mFromMin, dimensions ) + EstimateSourceCost( mFromMax, dimensions ) + EstimateSourceCost( mToMin, dimensions ) + EstimateSourceCost( mToMax, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
         HybridSource mFromMin = -1.0f;
@@ -240,6 +265,11 @@ namespace FastNoise
         void SetSource( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mSource, gen ); }
         void SetMinMax( float min, float max ) { mMin = min; mMax = max; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
         float mMin = -1.0f;
@@ -291,6 +321,11 @@ namespace FastNoise
         void SetSmoothness( float smoothness ) { mSmoothness = smoothness; if( smoothness != 0.0f ) mSmoothnessRecip = 1 + 1 / smoothness; }
         void SetSmoothness( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mSmoothness, gen ); }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions ) + EstimateSourceCost( mSmoothness, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
         HybridSource mSmoothness = 0.0f;
@@ -328,6 +363,11 @@ namespace FastNoise
         void SetPingPongStrength( float value ) { mPingPongStrength = value; }
         void SetPingPongStrength( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mPingPongStrength, gen ); }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions ) + EstimateSourceCost( mPingPongStrength, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
         HybridSource mPingPongStrength = 2.0f;
@@ -367,6 +407,11 @@ namespace FastNoise
         template<Dim D>
         void SetScaling( float value ) { mScale[(int)D] = value; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
         PerDimensionVariable<float> mScale = 1.0f;
@@ -401,6 +446,15 @@ namespace FastNoise
         void SetNewDimensionPosition( float value ) { mNewDimensionPosition = value; }
         void SetNewDimensionPosition( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mNewDimensionPosition, gen ); }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            if( dimensions >= 4 )
+            {
+                return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions );
+            }
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions + 1 ) + EstimateSourceCost( mNewDimensionPosition, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
         HybridSource mNewDimensionPosition = 0.0f;
@@ -433,6 +487,11 @@ namespace FastNoise
         void SetSource( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mSource, gen ); }
         void SetRemoveDimension( Dim dimension ) { mRemoveDimension = dimension; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, std::max( dimensions - 1, 2 ) );
+        }
+
     protected:
         GeneratorSource mSource;
         Dim mRemoveDimension = Dim::Y;
@@ -463,6 +522,11 @@ namespace FastNoise
 
         void SetSource( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mSource, gen ); }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
     };
@@ -492,6 +556,11 @@ namespace FastNoise
 
         void SetSource( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mSource, gen ); }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
     };
@@ -521,6 +590,11 @@ namespace FastNoise
 
         void SetSource( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mSource, gen ); }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
     };
@@ -556,6 +630,11 @@ namespace FastNoise
         void SetSource( SmartNodeArg<> gen ) { this->SetSourceMemberVariable( mSource, gen ); }
         void SetRotationType( PlaneRotationType type ) { mRotationType = type; }
 
+        float EstimateCost( int dimensions ) const override
+        {
+            return Generator::EstimateCost( dimensions ) + EstimateSourceCost( mSource, dimensions );
+        }
+
     protected:
         GeneratorSource mSource;
         PlaneRotationType mRotationType = PlaneRotationType::ImproveXYPlanes;
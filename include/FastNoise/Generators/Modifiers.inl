@@ -8,6 +8,8 @@ class FastSIMD::DispatchClass<DomainScale, SIMD> final : public virtual DomainSc
     template<typename... P> 
     FS_FORCEINLINE float32v GenT( int32v seed, P... pos ) const
     {
+        auto footprint = this->ScaleSampleFootprint( mScale );
+
         return this->GetSourceValue( mSource, seed, (pos * float32v( mScale ))... );
     }
 };
@@ -209,7 +211,10 @@ class FastSIMD::DispatchClass<DomainAxisScale, SIMD> final : public virtual Doma
     FS_FORCEINLINE float32v GenT( int32v seed, P... pos ) const
     {
         size_t idx = 0;
-        ((pos *= float32v( mScale[idx++] )), ...);
+        float maxScale = 0.0f;
+        ((maxScale = std::max( maxScale, std::abs( mScale[idx] ) ), pos *= float32v( mScale[idx++] )), ...);
+
+        auto footprint = this->ScaleSampleFootprint( maxScale );
 
         return this->GetSourceValue( mSource, seed, pos... );
     }
@@ -97,8 +97,32 @@ namespace FastNoise
 
             return FS::FMulAdd( gW, fW, FS::FMulAdd( gZ, fZ, FS::FMulAdd( gY, fY, gX * fX ) ) );
         }
+        else if constexpr( SIMD & FastSIMD::FeatureFlag::AVX2 )
+        {
+            // Same table as AVX512_F split into 8 wide halves
+            // Index bit 3 selects the upper half, bit 4 negates the result
+            float32v finalSign = FS::Cast<float>( ( index >> 31 ) << 31 );
+            int32v upperHalf = index << 1;
+            index >>= 27;
+
+            float32v gX = FS::SelectHighBit( upperHalf,
+                FS::NativeExec<float32v>( FS_BIND_INTRINSIC( _mm256_permutevar8x32_ps ), FS::Constant<float>( -1, 0, 1, 0, -1, 0, 0, 1 ), index ),
+                FS::NativeExec<float32v>( FS_BIND_INTRINSIC( _mm256_permutevar8x32_ps ), FS::Constant<float>( kSkew4f + 1, kSkew4f, kSkew4f, kSkew4f, -1, 1, 0, 0 ), index ) );
+            float32v gY = FS::SelectHighBit( upperHalf,
+                FS::NativeExec<float32v>( FS_BIND_INTRINSIC( _mm256_permutevar8x32_ps ), FS::Constant<float>( 0, -1, 0, 1, 0, -1, 1, 0 ), index ),
+                FS::NativeExec<float32v>( FS_BIND_INTRINSIC( _mm256_permutevar8x32_ps ), FS::Constant<float>( kSkew4f, kSkew4f + 1, kSkew4f, kSkew4f, 1, -1, 0, 0 ), index ) );
+            float32v gZ = FS::SelectHighBit( upperHalf,
+                FS::NativeExec<float32v>( FS_BIND_INTRINSIC( _mm256_permutevar8x32_ps ), FS::Constant<float>( 1, 0, -1, 0, 0, 1, -1, 0 ), index ),
+                FS::NativeExec<float32v>( FS_BIND_INTRINSIC( _mm256_permutevar8x32_ps ), FS::Constant<float>( kSkew4f, kSkew4f, kSkew4f + 1, kSkew4f, 0, 0, -1, 1 ), index ) );
+            float32v gW = FS::SelectHighBit( upperHalf,
+                FS::NativeExec<float32v>( FS_BIND_INTRINSIC( _mm256_permutevar8x32_ps ), FS::Constant<float>( 0, 1, 0, -1, 1, 0, 0, -1 ), index ),
+                FS::NativeExec<float32v>( FS_BIND_INTRINSIC( _mm256_permutevar8x32_ps ), FS::Constant<float>( kSkew4f, kSkew4f, kSkew4f, kSkew4f + 1, 0, 0, 1, -1 ), index ) );
+
+            return FS::FMulAdd( gW, fW, FS::FMulAdd( gZ, fZ, FS::FMulAdd( gY, fY, gX * fX ) ) ) ^ finalSign;
+        }
         else
         {
+            // Also used on ARM, NEON TBL indexes bytes so a 16 entry float table needs a 4 register lookup per component
             int32v indexA = index & int32v( 0x03 << 27 );
             int32v indexB = ( index >> 2 ) & int32v( 0x07 << 27 );
             indexB ^= indexA; // Simplifies the AVX512_F case.
@@ -1,5 +1,10 @@
 #pragma once
+#include <atomic>
+#include <cstddef>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
 #include <vector>
 #include <string>
 #include <cstdint>
@@ -14,6 +19,8 @@ namespace FastNoise
     struct PerDimensionVariable;
     struct Metadata;
     struct NodeData;
+    struct NodeDataProfileRegion;
+    struct NodeDataProfile;
 
     namespace Impl
     {
@@ -62,6 +69,65 @@ namespace FastNoise
             index_type mEnd = (index_type)-1;
         };
 
+        /** @brief Non-allocating function object used for member setters.
+         *
+         *  Stores a small trivially copyable callable (member function pointer plus captured indices) inline,
+         *  calling it is a single indirect call with no heap allocation or type erasure overhead.
+         */
+        template<typename SIG>
+        class SetterFunction;
+
+        template<typename R, typename... ARGS>
+        class SetterFunction<R( ARGS... )>
+        {
+        public:
+            SetterFunction() = default;
+
+            template<typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, SetterFunction>::value>::type>
+            SetterFunction( F func )
+            {
+                static_assert( std::is_trivially_copyable<F>::value && std::is_trivially_destructible<F>::value, "Setter captures must be trivially copyable" );
+                static_assert( sizeof( F ) <= sizeof( mStorage ) && alignof( F ) <= alignof( void* ), "Setter captures do not fit the inline storage" );
+
+                new( mStorage ) F( func );
+                mInvoke = []( const void* storage, ARGS... args ) -> R
+                {
+                    return ( *static_cast<const F*>( storage ) )( args... );
+                };
+            }
+
+            R operator()( ARGS... args ) const
+            {
+                return mInvoke( mStorage, args... );
+            }
+
+            explicit operator bool() const
+            {
+                return mInvoke != nullptr;
+            }
+
+        private:
+            alignas( void* ) unsigned char mStorage[4 * sizeof( void* )] = {};
+            R ( *mInvoke )( const void*, ARGS... ) = nullptr;
+        };
+
+        /** @brief Pointer offsets from Generator to the class declaring a member, one table per declaring class.
+         *
+         *  Created for each Metadata when its members are registered. An entry is resolved with dynamic_cast the
+         *  first time a node of each concrete type (one per compiled SIMD feature set) is set,
+         *  later sets apply the stored offset instead of walking the RTTI hierarchy.
+         */
+        struct MemberCastTable
+        {
+            static constexpr size_t kCapacity = 8;
+
+            explicit MemberCastTable( const std::type_info* type ) : declaringType( type ) {}
+
+            const std::type_info* declaringType;
+            std::atomic<const std::type_info*> nodeTypes[kCapacity] = {};
+            std::ptrdiff_t offsets[kCapacity] = {};
+        };
+
         /** @brief Name and description pair used when registering node parameters. */
         struct NameDesc
         {
@@ -134,7 +200,7 @@ namespace FastNoise
             /** @brief Set the value on a generator instance.
              *  @return true if the generator was the correct node class for this member.
              */
-            std::function<bool( Generator*, ValueUnion )> setFunc;
+            SetterFunction<bool( Generator*, ValueUnion )> setFunc;
         };
 
         /** @brief Describes a required generator source input on a node.
@@ -147,7 +213,7 @@ namespace FastNoise
             /** @brief Connect a source generator to this input.
              *  @return true if both the target generator and source node are the correct types.
              */
-            std::function<bool( Generator*, SmartNodeArg<> )> setFunc;
+            SetterFunction<bool( Generator*, SmartNodeArg<> )> setFunc;
         };
 
         /** @brief Describes a hybrid input that accepts either a constant float or a generator node.
@@ -164,12 +230,12 @@ namespace FastNoise
             /** @brief Set the constant float value.
              *  @return true if the generator was the correct node class.
              */
-            std::function<bool( Generator*, float )> setValueFunc;
+            SetterFunction<bool( Generator*, float )> setValueFunc;
 
             /** @brief Connect a generator node as the source (overrides constant value).
              *  @return true if both the generator and source node are the correct types.
              */
-            std::function<bool( Generator*, SmartNodeArg<> )> setNodeFunc;
+            SetterFunction<bool( Generator*, SmartNodeArg<> )> setNodeFunc;
         };
 
         using node_id = uint8_t;
@@ -236,6 +302,125 @@ namespace FastNoise
          */
         static NodeData* DeserialiseNodeData( const char* serialisedBase64NodeData, std::vector<std::unique_ptr<NodeData>>& nodeDataOut );
 
+        /** @brief Serialise a node data tree to the compact binary format.
+         *
+         *  The binary format is a versioned little endian buffer with 4 byte aligned records:
+         *  a 16 byte header, a table of 8 byte node records ordered children first (root last)
+         *  and a block of 8 byte parameter records. Shared nodes are stored once and referenced by index.
+         *  Every member value is stored, including defaults, so stored trees are not affected by default changes in later versions.
+         *  The buffer can be loaded directly from memory with FastNoise::NewFromBinaryNodeTree().
+         *
+         *  @param nodeData  Root node data to serialise.
+         *  @param fixUp     If true, removes dependency loops and invalid node types before serialising.
+         *  @return Binary node tree, or an empty vector on error.
+         */
+        static std::vector<uint8_t> SerialiseNodeDataBinary( NodeData* nodeData, bool fixUp = false );
+
+        /** @brief Create a generator tree from node data with every node in one contiguous arena.
+         *
+         *  @param nodeData       Root node data of the tree.
+         *  @param maxFeatureSet  Maximum SIMD feature set to use. Defaults to auto-detect.
+         *  @return Root node of the tree, or nullptr if the node data could not be serialised.
+         *  @see FastNoise::NewFromEncodedNodeTreeInArena
+         */
+        static SmartNode<> CreateNodeTreeInArena( NodeData* nodeData, FastSIMD::FeatureSet maxFeatureSet = FastSIMD::FeatureSet::Max );
+
+        /** @brief Compute a stable 64 bit structural hash of a node data tree.
+         *
+         *  Trees built separately hash equal if they produce the same output structure: operands of
+         *  commutative nodes (Add, Multiply, Min, Max...) are hashed independent of order, constants
+         *  of hybrid inputs connected to a node are ignored, -0/0 and NaN payloads are folded.
+         *  Node types are identified by name, so hashes are stable across runs and library builds.
+         *
+         *  @param nodeData  Root node data of the tree.
+         *  @return Structural hash, or 0 if the tree contains a dependency loop.
+         *  @see NodeDataStructurallyEqual
+         */
+        static uint64_t HashNodeData( const NodeData* nodeData );
+
+        /** @brief Deep structural comparison of two node data trees, using the same rules as HashNodeData().
+         *
+         *  Equal trees always have equal hashes. No serialisation or allocation of encoded strings is required.
+         *  @return true if both trees are structurally equal, false if they differ or either contains a dependency loop.
+         */
+        static bool NodeDataStructurallyEqual( const NodeData* lhs, const NodeData* rhs );
+
+        /** @brief Rewrite a node data tree into an equivalent tree that is cheaper to generate.
+         *
+         *  Removes identity nodes (Add 0, Multiply/Divide 1, Subtract 0, DomainScale/DomainAxisScale 1,
+         *  DomainOffset 0, SeedOffset 0, unclamped identity Remap), merges nested DomainScale,
+         *  DomainAxisScale, DomainOffset and SeedOffset chains, inlines Constant nodes connected to hybrid
+         *  inputs and folds operators with only constant inputs into a Constant.
+         *  Merged scales and removed remaps can differ from the original output by float rounding.
+         *  Removing an add of 0 keeps -0 outputs of its source, which the add turned into +0.
+         *
+         *  Nodes are modified in place, pass a copy of the tree if the original must be kept.
+         *
+         *  @param nodeData          Root node data of the tree.
+         *  @param[out] nodeDataOut  Receives ownership of any NodeData created by the pass.
+         *  @param[out] changesOut   Optional, receives a description of each change made.
+         *  @return Root of the simplified tree, may differ from nodeData.
+         */
+        static NodeData* SimplifyNodeData( NodeData* nodeData, std::vector<std::unique_ptr<NodeData>>& nodeDataOut, std::vector<std::string>* changesOut = nullptr );
+
+        /** @brief Simplify an encoded node tree, see SimplifyNodeData().
+         *
+         *  Use this before FastNoise::NewFromEncodedNodeTree() to generate from the simplified tree.
+         *  @param serialisedBase64NodeData  Encoded node tree string.
+         *  @param[out] changesOut           Optional, receives a description of each change made.
+         *  @return Encoded simplified tree, or an empty string if the input is invalid.
+         */
+        static std::string SimplifyEncodedNodeTree( const char* serialisedBase64NodeData, std::vector<std::string>* changesOut = nullptr );
+
+        /** @brief Sample every node in a node data tree over representative regions, recording output ranges and branch statistics.
+         *
+         *  Each node is generated as its own tree and keeps its output for every sample, so keep the
+         *  total sample count moderate. The result is used by SpecializeNodeData().
+         *
+         *  Nodes below a source that sees a changed position or seed (the source of domain modifiers, Seed Offset,
+         *  fractals and domain warps, cellular lookups, Minkowski P) are not profiled, since the regions don't describe
+         *  the inputs they see in the tree. This includes nodes also reachable through a path without such a source.
+         *  Other hybrids, such as fractal Gain or warp amplitude, are evaluated at the node's own inputs and are profiled.
+         *
+         *  @param nodeData       Root node data of the tree.
+         *  @param regions        Regions to sample, use the positions, frequencies and seeds the tree is generated with.
+         *  @param maxFeatureSet  Maximum SIMD feature set to use for sampling.
+         *  @return One profile per node that could be generated, in depth first order from the root.
+         */
+        static std::vector<NodeDataProfile> ProfileNodeData( NodeData* nodeData, const std::vector<NodeDataProfileRegion>& regions, FastSIMD::FeatureSet maxFeatureSet = FastSIMD::FeatureSet::Max );
+
+        /** @brief Rewrite a node data tree into a variant specialized for the regions it was profiled over.
+         *
+         *  Short-circuits branches that were predictable for every profiled sample: Fade and Select nodes always
+         *  fully at A or B are replaced by that input, Min/Max nodes that always selected the same input are replaced
+         *  by it, Clamp Output is disabled on Remap nodes that never clamped and nodes with an output range
+         *  within constantTolerance are replaced by a Constant. SimplifyNodeData() then runs on the result.
+         *
+         *  Only nodes with a profile are changed, see ProfileNodeData() for the nodes that are not profiled.
+         *  The variant only matches the original tree within the profiled regions, up to float rounding.
+         *  Nodes are modified in place, pass a copy of the tree if the original must be kept.
+         *
+         *  @param nodeData           Root node data of the tree passed to ProfileNodeData().
+         *  @param profile            Result of ProfileNodeData().
+         *  @param[out] nodeDataOut   Receives ownership of any NodeData created by the pass.
+         *  @param[out] changesOut    Optional, receives a description of each change made.
+         *  @param constantTolerance  Nodes with an output range up to this width are replaced by a Constant of its midpoint.
+         *  @return Root of the specialized tree, may differ from nodeData.
+         */
+        static NodeData* SpecializeNodeData( NodeData* nodeData, const std::vector<NodeDataProfile>& profile, std::vector<std::unique_ptr<NodeData>>& nodeDataOut,
+                                             std::vector<std::string>* changesOut = nullptr, float constantTolerance = 0.0f );
+
+        /** @brief Profile and specialize an encoded node tree, see ProfileNodeData() and SpecializeNodeData().
+         *
+         *  @param serialisedBase64NodeData  Encoded node tree string.
+         *  @param regions                   Regions to profile, the result is only valid within them.
+         *  @param[out] changesOut           Optional, receives a description of each change made.
+         *  @param constantTolerance         See SpecializeNodeData().
+         *  @return Encoded specialized tree, or an empty string if the input is invalid.
+         */
+        static std::string SpecializeEncodedNodeTree( const char* serialisedBase64NodeData, const std::vector<NodeDataProfileRegion>& regions,
+                                                      std::vector<std::string>* changesOut = nullptr, float constantTolerance = 0.0f );
+
         /** @brief Format a node class name for display by inserting spaces at word boundaries.
          *
          *  For example: `DomainScale` becomes `"Domain Scale"`.
@@ -271,6 +456,19 @@ namespace FastNoise
          */
         virtual SmartNode<> CreateNode( FastSIMD::FeatureSet maxFeatureSet = FastSIMD::FeatureSet::Max ) const = 0;
 
+        /** @brief Get the estimated cost of generating one sample with this node type, excluding its sources.
+         *
+         *  The shipped cost table holds uncalibrated estimates for each node type, only relative costs are meaningful.
+         *  Replace it with the output of FastNoiseBenchmark --calibrate_cost, see NodeCostTable.inl, to get per feature set costs for a machine.
+         *  Cellular costs include searching the 3^N cell neighbourhood.
+         *
+         *  @param dimensions  Number of generated dimensions: 2, 3 or 4.
+         *  @param featureSet  SIMD feature set the node is running with.
+         *  @return Cost in nanoseconds per sample, 0 if @p dimensions is out of range.
+         *  @see Generator::EstimateCost
+         */
+        float GetSampleCost( int dimensions, FastSIMD::FeatureSet featureSet ) const;
+
         node_id id;                                ///< Unique numeric identifier for this node type.
         Vector<MemberVariable>   memberVariables;  ///< Float, int, and enum parameters.
         Vector<MemberNodeLookup> memberNodeLookups; ///< Required generator source inputs.
@@ -280,6 +478,7 @@ namespace FastNoise
         const char* name = "";            ///< Node class name (e.g. "Simplex", "FractalFBm").
         const char* description = "";     ///< Human-readable description of the node's behaviour.
         const char* formattedName = nullptr; ///< Cached formatted display name, or nullptr if not yet formatted.
+        bool commutativeOperands = false; ///< First node lookup and first hybrid input can be swapped without changing the output.
 
     protected:
         Metadata()
@@ -290,6 +489,8 @@ namespace FastNoise
         static constexpr float kDefaultUiDragSpeedFloat = 0.02f;
         static constexpr float kDefaultUiDragSpeedInt = 0.2f;
 
+        std::vector<std::unique_ptr<MemberCastTable>> mMemberCastTables; ///< Shared by all setters of this node type, see MemberCastTable.
+
     private:
         static node_id AddMetadata( const Metadata* newMetadata )
         {
@@ -318,6 +519,10 @@ namespace FastNoise
         {
             if( ( metadata = data ) )
             {
+                // One exact size allocation per member vector
+                variables.reserve( metadata->memberVariables.size() );
+                hybrids.reserve( metadata->memberHybrids.size() );
+
                 for( const Metadata::MemberVariable& value: metadata->memberVariables )
                 {
                     variables.push_back( value.valueDefault );
@@ -345,4 +550,35 @@ namespace FastNoise
                 hybrids == rhs.hybrids;
         }
     };
+
+    /** @brief Uniform grid of sample positions used by Metadata::ProfileNodeData(). */
+    struct NodeDataProfileRegion
+    {
+        int dimensions = 2;                ///< 2, 3 or 4.
+        float start[4] = {};               ///< Position of the first sample on each axis.
+        int count[4] = { 32, 32, 32, 32 }; ///< Samples on each axis, axes past dimensions are ignored.
+        float step[4] = { 1, 1, 1, 1 };    ///< Distance between samples on each axis.
+        int seed = 1337;                   ///< Generation seed.
+    };
+
+    /** @brief Output range and branch statistics of one node, returned by Metadata::ProfileNodeData().
+     *
+     *  Branch counts depend on the node type:
+     *  - Fade/Select: samples fully at A (low) and fully at B (high).
+     *  - Remap: samples below To Min (low) and above To Max (high), whether or not Clamp Output is enabled.
+     *  - Min/Max: samples where LHS (low) or RHS (high) is selected, ties count as neither.
+     *  - Other nodes: 0.
+     *
+     *  Samples with NaN inputs count as both low and high for Remap and Min/Max, and as neither for Fade/Select.
+     */
+    struct NodeDataProfile
+    {
+        const NodeData* nodeData = nullptr; ///< Profiled node.
+        size_t samples = 0;                 ///< Samples generated.
+        size_t nanSamples = 0;              ///< NaN outputs, excluded from min and max.
+        float min = 0;                      ///< Smallest output.
+        float max = 0;                      ///< Largest output.
+        size_t branchLow = 0;               ///< See type specific meaning above.
+        size_t branchHigh = 0;              ///< See type specific meaning above.
+    };
 }
@@ -4,6 +4,16 @@
 
 #define FASTNOISE_CALC_MIN_MAX true
 
+// Per-node profiling instrumentation, enabled by the FASTNOISE2_PROFILING CMake option
+#ifndef FASTNOISE_PROFILING
+#define FASTNOISE_PROFILING false
+#endif
+
+// Generation call counters and tracing callbacks, enabled by the FASTNOISE2_TRACING CMake option
+#ifndef FASTNOISE_TRACING
+#define FASTNOISE_TRACING false
+#endif
+
 namespace FastNoise
 {    
     class Generator;
@@ -0,0 +1,132 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Config.h"
+
+namespace FastNoise
+{
+    /** @brief Generation function used for a traced call. */
+    enum class GenerationCallType : uint8_t
+    {
+        UniformGrid2D,
+        UniformGrid3D,
+        UniformGrid4D,
+        PositionArray2D,
+        PositionArray3D,
+        PositionArray4D,
+        Single2D,
+        Single3D,
+        Single4D,
+        Tileable2D,
+        Count
+    };
+
+    /** @brief Describes a generation call, passed to GenerationTracer callbacks. */
+    struct GenerationCallInfo
+    {
+        const Generator* node;   ///< Root node the generation function was called on.
+        GenerationCallType type; ///< Generation function.
+        size_t samples;          ///< Number of samples requested.
+    };
+
+    /** @brief Counters for all generation calls made on one root node, returned by GenerationTracer::GetSnapshot().
+     *
+     *  Histograms use power of 2 buckets: bucket i counts values in [2^(i-1), 2^i), bucket 0 counts 0.
+     *  The last bucket also counts all larger values.
+     */
+    struct GenerationStats
+    {
+        static constexpr size_t kHistogramBuckets = 32;
+
+        const Generator* node = nullptr;    ///< Root node, do not dereference once the node may have been released.
+        const Metadata* metadata = nullptr; ///< Node type of the root node.
+        uint64_t calls = 0;                 ///< Generation calls.
+        uint64_t samples = 0;               ///< Samples generated.
+        uint64_t totalNs = 0;               ///< Time spent in generation calls.
+        uint64_t maxNs = 0;                 ///< Longest generation call.
+        uint64_t callTypeCounts[(size_t)GenerationCallType::Count] = {}; ///< Calls per generation function.
+        uint64_t samplesHistogram[kHistogramBuckets] = {}; ///< Distribution of samples per call.
+        uint64_t latencyHistogram[kHistogramBuckets] = {}; ///< Distribution of nanoseconds per call.
+
+        /** @brief Samples generated per second of generation time. */
+        double SamplesPerSecond() const
+        {
+            return totalNs ? (double)samples * 1e9 / (double)totalNs : 0.0;
+        }
+
+        /** @brief Estimate a call latency percentile from the latency histogram.
+         *  @param percentile  Percentile in [0, 100], for example 99 for the p99 latency.
+         *  @return Upper bound of the histogram bucket containing the percentile in nanoseconds, capped at maxNs.
+         */
+        uint64_t LatencyPercentileNs( double percentile ) const
+        {
+            uint64_t target = std::max<uint64_t>( (uint64_t)std::ceil( (double)calls * percentile / 100.0 ), 1 );
+            uint64_t count = 0;
+
+            for( size_t i = 0; i + 1 < kHistogramBuckets; i++ )
+            {
+                if( ( count += latencyHistogram[i] ) >= target )
+                {
+                    return std::min( i ? ( (uint64_t)1 << i ) - 1 : 0, maxNs );
+                }
+            }
+            return maxNs;
+        }
+    };
+
+    /** @brief Counters and tracing hooks for generation calls.
+     *
+     *  Only available when the library is built with the FASTNOISE2_TRACING CMake option, without it
+     *  generation calls are not instrumented at all and every function here is a no-op.
+     *  When available, each generation call (GenUniformGrid, GenPositionArray, GenSingle, GenTileable)
+     *  updates lock free counters for its root node and runs the begin/end callbacks if set.
+     *
+     *  Counters are kept for a fixed number of root nodes, calls on further nodes are counted in an
+     *  overflow entry with a null node. Entries are keyed by node address, call Reset() after releasing
+     *  traced trees if addresses may be reused.
+     */
+    class FASTNOISE_API GenerationTracer
+    {
+    public:
+        /** @brief Called on the generating thread before generation starts. */
+        using BeginCallback = void (*)( const GenerationCallInfo& call, void* userData );
+
+        /** @brief Called on the generating thread after generation completes. */
+        using EndCallback = void (*)( const GenerationCallInfo& call, uint64_t durationNs, void* userData );
+
+        static constexpr size_t kMaxTrackedNodes = 256;
+
+        GenerationTracer() = delete;
+
+        /** @brief True if the library was built with generation call instrumentation. */
+        static bool IsAvailable();
+
+        /** @brief Enable or disable counter updates, enabled by default. Callbacks run regardless. */
+        static void SetCountersEnabled( bool enabled );
+
+        /** @brief Set the callbacks run around every generation call, pass nullptr to remove.
+         *
+         *  Callbacks may run concurrently on any thread that generates noise and must be thread safe.
+         *  Calls that started before the callbacks were replaced may still use the previous callbacks.
+         */
+        static void SetCallbacks( BeginCallback begin, EndCallback end, void* userData );
+
+        /** @brief Copy the counters of every traced root node.
+         *
+         *  Counters are read independently without locking, a snapshot taken during generation
+         *  may be slightly inconsistent.
+         */
+        static std::vector<GenerationStats> GetSnapshot();
+
+        /** @brief Clear all counters and tracked nodes. Must not be called while generation is running. */
+        static void Reset();
+
+        // Instrumentation hooks used by generator implementations in tracing builds
+        static uint64_t BeginCall( const GenerationCallInfo& call );
+        static void EndCall( const GenerationCallInfo& call, uint64_t startNs );
+    };
+}
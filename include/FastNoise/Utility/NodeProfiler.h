@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Config.h"
+
+namespace FastNoise
+{
+    /** @brief Time spent in one node of a profiled call tree, returned by NodeProfiler::GetResults().
+     *
+     *  Entries are keyed by call path: a node instance used as the source of two different
+     *  nodes appears once under each parent.
+     */
+    struct NodeProfile
+    {
+        const Generator* node = nullptr;    ///< Profiled node instance, do not dereference once the node may have been released.
+        const Metadata* metadata = nullptr; ///< Node type.
+        std::string name;                   ///< Display name from Metadata::FormatMetadataNodeName().
+        int parent = -1;                    ///< Index of the calling node in the results, -1 for generation call roots.
+        int depth = 0;                      ///< Call depth, 0 for generation call roots.
+        uint64_t calls = 0;                 ///< Generation calls for roots, SIMD vector evaluations for source nodes.
+        uint64_t samples = 0;               ///< Samples generated by this node.
+        double inclusiveNs = 0;             ///< Time spent in this node and its sources.
+        double exclusiveNs = 0;             ///< Time spent in this node, excluding its sources.
+    };
+
+    /** @brief Attributes generation time, call counts and samples to each node in a node tree.
+     *
+     *  Per-node timing is only recorded when the library is built with the FASTNOISE2_PROFILING
+     *  CMake option, it wraps every source node evaluation with a timer so generation is
+     *  significantly slower. Use the relative exclusive times to find which nodes are expensive.
+     *  Without the option all functions are available but Begin() returns false.
+     *
+     *  Generation calls on any thread between Begin() and End() are recorded.
+     *  Warp kernels evaluated directly by domain warp fractals are attributed to the fractal node.
+     *
+     *  @code
+     *  if( FastNoise::NodeProfiler::Begin() )
+     *  {
+     *      generator->GenUniformGrid3D( noise.data(), 0, 0, 0, 64, 64, 64, 0.02f, 0.02f, 0.02f, 1337 );
+     *      FastNoise::NodeProfiler::End();
+     *      printf( "%s", FastNoise::NodeProfiler::FormatResults( FastNoise::NodeProfiler::GetResults() ).c_str() );
+     *  }
+     *  @endcode
+     */
+    class FASTNOISE_API NodeProfiler
+    {
+    public:
+        NodeProfiler() = delete;
+
+        /** @brief True if the library was built with per-node profiling instrumentation. */
+        static bool IsAvailable();
+
+        /** @brief Start a new profiling session, discarding results from the previous session.
+         *  @return false if profiling instrumentation is not available in this build.
+         */
+        static bool Begin();
+
+        /** @brief Stop recording. Results stay available until the next Begin(). */
+        static void End();
+
+        /** @brief Get the merged results of all threads as a depth first call tree.
+         *
+         *  Children follow their parent and are sorted by inclusive time.
+         *  Waits for generation calls currently being recorded on other threads to complete.
+         *
+         *  @param root  Only include generation calls made on this node, nullptr for all calls.
+         *  @return Profiled nodes, empty if nothing was recorded.
+         */
+        static std::vector<NodeProfile> GetResults( const Generator* root = nullptr );
+
+        /** @brief Format results as an indented table, one line per node. */
+        static std::string FormatResults( const std::vector<NodeProfile>& results );
+
+        // Instrumentation hooks used by generator implementations in profiling builds
+        static bool EnterNode( const Generator* node, size_t samples );
+        static void ExitNode();
+    };
+}
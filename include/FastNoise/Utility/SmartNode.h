@@ -10,10 +10,26 @@
 
 namespace FastNoise
 {
+    /** @brief Snapshot of node memory pool usage, returned by SmartNodeManager::GetMemoryStats().
+     *
+     *  Counters are sampled independently without locking, so a snapshot taken while other
+     *  threads create or release nodes may be slightly inconsistent.
+     */
+    struct SmartNodeMemoryStats
+    {
+        uint64_t liveBytes;         ///< Bytes in blocks currently owned by nodes
+        uint64_t liveAllocations;   ///< Number of nodes currently allocated
+        uint64_t threadCachedBytes; ///< Bytes in freed blocks held by per-thread caches
+        uint64_t poolBytes;         ///< Total bytes reserved by all pools
+        uint32_t poolCount;         ///< Number of pools
+        float fragmentation;        ///< 1 - liveBytes / poolBytes, 0 when no pools exist
+    };
+
     /** @brief Manages the memory pool used by SmartNode for allocating generator nodes.
      *
      *  All FastNoise generator nodes are allocated from an internal memory pool for
-     *  cache-friendly layout and fast allocation. This class is not directly instantiated;
+     *  cache-friendly layout and fast allocation. Each pool serves a single size class and
+     *  reuses freed blocks, with a small per-thread cache in front of the pools. This class is not directly instantiated;
      *  use SetMemoryPoolSize() before creating nodes if you need to adjust the pool.
      */
     class FASTNOISE_API SmartNodeManager
@@ -26,10 +42,51 @@ namespace FastNoise
         /** @brief Set the size of the node memory pool in bytes.
          *
          *  Call this before creating any nodes if the default pool size is insufficient.
+         *  Pools are aligned to their size rounded up to a power of two, which is fixed once the first node is created.
          *  @param size  Pool size in bytes.
          */
         static void SetMemoryPoolSize( uint32_t size );
 
+        /** @brief Get current node memory usage across all pools.
+         *
+         *  Useful for monitoring long running processes that continuously create and release node trees.
+         *  @return Snapshot of live bytes, pool count and fragmentation.
+         */
+        static SmartNodeMemoryStats GetMemoryStats();
+
+        /** @brief Places every node created on the calling thread into one contiguous arena while in scope.
+         *
+         *  Nodes are laid out in creation order, so a tree built depth first inside a scope sits
+         *  in evaluation order and the recursive Gen() walk stays within neighbouring cache lines.
+         *  The arena is released as a unit once the scope has ended and every node in it has been freed.
+         *  Nodes that do not fit in the arena fall back to the regular pools.
+         *  Scopes can be nested, the innermost scope on the thread is used.
+         *
+         *  FastNoise::NewFromEncodedNodeTreeInArena() and Metadata::CreateNodeTreeInArena() wrap this for whole trees.
+         */
+        class FASTNOISE_API ArenaScope
+        {
+        public:
+            /** @param capacity  Arena size in bytes, 0 only measures the space nodes created in scope would need.
+             */
+            explicit ArenaScope( size_t capacity );
+            ~ArenaScope();
+
+            ArenaScope( const ArenaScope& ) = delete;
+            ArenaScope& operator=( const ArenaScope& ) = delete;
+
+            /** @return Bytes an arena needs to hold every node created in this scope so far, including alignment padding.
+             */
+            size_t GetRequiredSize() const { return mRequiredSize; }
+
+        private:
+            friend class SmartNodeManager;
+
+            ArenaScope* mPrevious;
+            void* mArena;
+            size_t mRequiredSize;
+        };
+
     private:
         template<typename>
         friend struct MetadataT;
@@ -65,6 +122,10 @@ namespace FastNoise
      *  FastNoise::SmartNode<> generic = simplex;             // implicit upcast to SmartNode<Generator>
      *  @endcode
      *
+     *  Copies update a reference count stored in the node, so avoid copying one SmartNode per task
+     *  when many threads share a tree. Keep one SmartNode alive and pass get() to tasks that
+     *  finish before it is released.
+     *
      *  @tparam T  Generator-derived type. Defaults to Generator for type-erased usage.
      */
     template<typename T>
@@ -2,6 +2,15 @@
 #include <FastNoise/FastNoise.h>
 #include <FastNoise/Metadata.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace FastNoise::Internal
 {
     // Manually bump the reference count on a raw Generator pointer. Avoids
@@ -64,6 +73,11 @@ int fnGetMetadataID( const void* node )
     return ToGen( node )->GetMetadata().id;
 }
 
+float fnEstimateCost( const void* node, int dimensions )
+{
+    return ToGen( node )->EstimateCost( dimensions );
+}
+
 void fnGenUniformGrid2D( const void* node, float* noiseOut, float xOffset, float yOffset, int xCount, int yCount, float xStepSize, float yStepSize, int seed, float* outputMinMax )
 {
     StoreMinMax( outputMinMax, ToGen( node )->GenUniformGrid2D( noiseOut, xOffset, yOffset, xCount, yCount, xStepSize, yStepSize, seed ) );    
@@ -94,6 +108,272 @@ void fnGenPositionArray4D( const void* node, float* noiseOut, int count, const f
     StoreMinMax( outputMinMax, ToGen( node )->GenPositionArray4D( noiseOut, count, xPosArray, yPosArray, zPosArray, wPosArray, xOffset, yOffset, zOffset, wOffset, seed ) );
 }
 
+namespace
+{
+    // Persistent worker threads shared by all fnGenUniformGridBatch calls
+    // Created on first use and only destroyed by fnShutdownBatchPool(), never from a static destructor
+    // since joining threads there deadlocks under the Windows loader lock and races other static destructors
+    class BatchWorkerPool
+    {
+    public:
+        struct Batch
+        {
+            fnBatchTaskFunc task;
+            void* taskData;
+            int taskCount;
+            int maxWorkers;
+            int activeWorkers = 0; // Guarded by mMutex
+            std::atomic<int> nextTask = 0;
+        };
+
+        // Running batches hold a reference, so a shut down pool is joined once the last batch using it finishes
+        static std::shared_ptr<BatchWorkerPool> Acquire()
+        {
+            Instance& instance = GetInstance();
+            std::lock_guard lock( instance.mutex );
+
+            if( !instance.pool )
+            {
+                instance.pool.reset( new BatchWorkerPool );
+            }
+            return instance.pool;
+        }
+
+        static void Shutdown()
+        {
+            std::shared_ptr<BatchWorkerPool> pool;
+            {
+                Instance& instance = GetInstance();
+                std::lock_guard lock( instance.mutex );
+                pool.swap( instance.pool );
+            }
+        }
+
+        ~BatchWorkerPool()
+        {
+            {
+                std::lock_guard lock( mMutex );
+                mStop = true;
+            }
+            mWorkCondition.notify_all();
+
+            for( std::thread& thread : mThreads )
+            {
+                thread.join();
+            }
+        }
+
+        size_t ThreadCount() const
+        {
+            return mThreads.size();
+        }
+
+        void Run( Batch& batch )
+        {
+            {
+                std::lock_guard lock( mMutex );
+                mBatches.push_back( &batch );
+            }
+            mWorkCondition.notify_all();
+
+            Work( batch );
+
+            // All tasks are claimed, wait for workers still running one
+            std::unique_lock lock( mMutex );
+            mBatches.erase( std::find( mBatches.begin(), mBatches.end(), &batch ) );
+            mDoneCondition.wait( lock, [&batch] { return batch.activeWorkers == 0; } );
+        }
+
+    private:
+        BatchWorkerPool()
+        {
+            unsigned threadCount = std::max( std::thread::hardware_concurrency(), 2u ) - 1;
+
+            for( unsigned i = 0; i < threadCount; i++ )
+            {
+                mThreads.emplace_back( [this] { WorkerLoop(); } );
+            }
+        }
+
+        struct Instance
+        {
+            std::mutex mutex;
+            std::shared_ptr<BatchWorkerPool> pool;
+        };
+
+        // Intentionally leaked, worker threads still blocked at process exit are ended by the OS
+        static Instance& GetInstance()
+        {
+            static Instance* instance = new Instance;
+            return *instance;
+        }
+
+        static void Work( Batch& batch )
+        {
+            int taskIndex;
+            while( ( taskIndex = batch.nextTask.fetch_add( 1, std::memory_order_relaxed ) ) < batch.taskCount )
+            {
+                batch.task( batch.taskData, taskIndex );
+            }
+        }
+
+        // Requires mMutex
+        Batch* FindBatch() const
+        {
+            for( Batch* batch : mBatches )
+            {
+                if( batch->activeWorkers < batch->maxWorkers && batch->nextTask.load( std::memory_order_relaxed ) < batch->taskCount )
+                {
+                    return batch;
+                }
+            }
+            return nullptr;
+        }
+
+        void WorkerLoop()
+        {
+            std::unique_lock lock( mMutex );
+
+            while( true )
+            {
+                Batch* batch;
+                mWorkCondition.wait( lock, [&] { return mStop || ( batch = FindBatch() ); } );
+
+                if( mStop )
+                {
+                    return;
+                }
+
+                batch->activeWorkers++;
+                lock.unlock();
+
+                Work( *batch );
+
+                lock.lock();
+                if( --batch->activeWorkers == 0 )
+                {
+                    mDoneCondition.notify_all();
+                }
+            }
+        }
+
+        std::vector<std::thread> mThreads;
+        std::vector<Batch*> mBatches;
+        std::mutex mMutex;
+        std::condition_variable mWorkCondition;
+        std::condition_variable mDoneCondition;
+        bool mStop = false;
+    };
+
+    bool ValidateUniformGridJobs( const fnUniformGridJob* jobs, int jobCount )
+    {
+        if( jobCount < 0 || ( jobCount && !jobs ) )
+        {
+            return false;
+        }
+
+        for( int i = 0; i < jobCount; i++ )
+        {
+            const fnUniformGridJob& job = jobs[i];
+
+            if( !job.node || !job.noiseOut || job.dimensions < 2 || job.dimensions > 4 )
+            {
+                return false;
+            }
+
+            for( int dim = 0; dim < job.dimensions; dim++ )
+            {
+                if( job.count[dim] < 0 )
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void RunUniformGridJob( void* taskData, int taskIndex )
+    {
+        fnUniformGridJob& job = static_cast<fnUniformGridJob*>( taskData )[taskIndex];
+        const FastNoise::Generator* generator = ToGen( job.node );
+        FastNoise::OutputMinMax minMax;
+
+        switch( job.dimensions )
+        {
+        case 2:
+            minMax = generator->GenUniformGrid2D( job.noiseOut, job.offset[0], job.offset[1], job.count[0], job.count[1], job.stepSize[0], job.stepSize[1], job.seed );
+            break;
+        case 3:
+            minMax = generator->GenUniformGrid3D( job.noiseOut, job.offset[0], job.offset[1], job.offset[2], job.count[0], job.count[1], job.count[2], job.stepSize[0], job.stepSize[1], job.stepSize[2], job.seed );
+            break;
+        case 4:
+            minMax = generator->GenUniformGrid4D( job.noiseOut, job.offset[0], job.offset[1], job.offset[2], job.offset[3], job.count[0], job.count[1], job.count[2], job.count[3], job.stepSize[0], job.stepSize[1], job.stepSize[2], job.stepSize[3], job.seed );
+            break;
+        }
+
+        StoreMinMax( job.outputMinMax, minMax );
+    }
+}
+
+bool fnGenUniformGridBatch( fnUniformGridJob* jobs, int jobCount, int maxThreads )
+{
+    if( !ValidateUniformGridJobs( jobs, jobCount ) )
+    {
+        return false;
+    }
+
+    if( jobCount == 0 )
+    {
+        return true;
+    }
+
+    std::shared_ptr<BatchWorkerPool> pool = BatchWorkerPool::Acquire();
+    int maxWorkers = std::min( jobCount, (int)pool->ThreadCount() + 1 );
+
+    if( maxThreads > 0 )
+    {
+        maxWorkers = std::min( maxWorkers, maxThreads );
+    }
+
+    // Workers help the calling thread
+    BatchWorkerPool::Batch batch;
+    batch.task = &RunUniformGridJob;
+    batch.taskData = jobs;
+    batch.taskCount = jobCount;
+    batch.maxWorkers = maxWorkers - 1;
+
+    if( batch.maxWorkers <= 0 )
+    {
+        for( int i = 0; i < jobCount; i++ )
+        {
+            RunUniformGridJob( jobs, i );
+        }
+        return true;
+    }
+
+    pool->Run( batch );
+    return true;
+}
+
+void fnShutdownBatchPool()
+{
+    BatchWorkerPool::Shutdown();
+}
+
+bool fnGenUniformGridBatchSubmit( fnUniformGridJob* jobs, int jobCount, fnBatchSubmitFunc submit, void* userData )
+{
+    if( !submit || !ValidateUniformGridJobs( jobs, jobCount ) )
+    {
+        return false;
+    }
+
+    if( jobCount > 0 )
+    {
+        submit( userData, &RunUniformGridJob, jobs, jobCount );
+    }
+    return true;
+}
+
 float fnGenSingle2D( const void* node, float x, float y, int seed )
 {
     return ToGen( node )->GenSingle2D( x, y, seed );
@@ -114,6 +394,46 @@ void fnGenTileable2D( const void* node, float* noiseOut, int xSize, int ySize, f
     StoreMinMax( outputMinMax, ToGen( node )->GenTileable2D( noiseOut, xSize, ySize, xStepSize, yStepSize, seed ) );
 }
 
+bool fnBeginNodeProfiling()
+{
+    return FastNoise::NodeProfiler::Begin();
+}
+
+void fnEndNodeProfiling()
+{
+    FastNoise::NodeProfiler::End();
+}
+
+int fnGetNodeProfile( const void* rootNode, fnNodeProfile* profileOut, int maxCount )
+{
+    std::vector<FastNoise::NodeProfile> results = FastNoise::NodeProfiler::GetResults( ToGen( rootNode ) );
+
+    if( profileOut )
+    {
+        for( int i = 0; i < std::min( maxCount, (int)results.size() ); i++ )
+        {
+            const FastNoise::NodeProfile& result = results[i];
+
+            profileOut[i] = { result.metadata->id, result.parent, result.depth, result.calls, result.samples, result.inclusiveNs, result.exclusiveNs };
+        }
+    }
+    return (int)results.size();
+}
+
+int fnFormatNodeProfile( const void* rootNode, char* buffer, int bufferSize )
+{
+    std::string string = FastNoise::NodeProfiler::FormatResults( FastNoise::NodeProfiler::GetResults( ToGen( rootNode ) ) );
+
+    if( buffer && bufferSize > 0 )
+    {
+        size_t length = std::min( string.size(), (size_t)bufferSize - 1 );
+
+        std::memcpy( buffer, string.data(), length );
+        buffer[length] = 0;
+    }
+    return (int)string.size() + 1;
+}
+
 int fnGetMetadataCount()
 {
     return (int)FastNoise::Metadata::GetAll().size();
@@ -141,3 +141,6 @@ FASTNOISE_REGISTER_NODE( RemoveDimension );
 
 FASTNOISE_REGISTER_NODE( Modulus );
 FASTNOISE_REGISTER_NODE( DomainRotatePlane );
+
+FASTNOISE_REGISTER_NODE( Select );
+FASTNOISE_REGISTER_NODE( Switch );
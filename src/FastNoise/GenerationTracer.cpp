@@ -0,0 +1,229 @@
+#include <FastNoise/Utility/GenerationTracer.h>
+#include <FastNoise/FastNoise.h>
+#include <FastNoise/Metadata.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace FastNoise
+{
+    namespace
+    {
+        struct TraceCounters
+        {
+            std::atomic<const Generator*> node = nullptr;
+            std::atomic<const Metadata*> metadata = nullptr;
+            std::atomic<uint64_t> calls = 0;
+            std::atomic<uint64_t> samples = 0;
+            std::atomic<uint64_t> totalNs = 0;
+            std::atomic<uint64_t> maxNs = 0;
+            std::atomic<uint64_t> callTypeCounts[(size_t)GenerationCallType::Count] = {};
+            std::atomic<uint64_t> samplesHistogram[GenerationStats::kHistogramBuckets] = {};
+            std::atomic<uint64_t> latencyHistogram[GenerationStats::kHistogramBuckets] = {};
+        };
+
+        struct TraceCallbacks
+        {
+            GenerationTracer::BeginCallback begin;
+            GenerationTracer::EndCallback end;
+            void* userData;
+        };
+
+        // Open addressed by node address, slots are claimed once and never released until Reset()
+        // The extra slot counts calls once every slot is claimed
+        TraceCounters gTraceCounters[GenerationTracer::kMaxTrackedNodes + 1];
+
+        std::atomic<bool> gCountersEnabled = true;
+        std::atomic<const TraceCallbacks*> gTraceCallbacks = nullptr;
+
+        uint64_t NowNs()
+        {
+            return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+        }
+
+        size_t HistogramBucket( uint64_t value )
+        {
+            size_t bucket = 0;
+            while( value && bucket < GenerationStats::kHistogramBuckets - 1 )
+            {
+                value >>= 1;
+                bucket++;
+            }
+            return bucket;
+        }
+
+        TraceCounters& FindCounters( const Generator* node )
+        {
+            size_t slot = ( (uintptr_t)node >> 6 ) * 0x9E3779B97F4A7C15ull >> 32;
+
+            for( size_t probe = 0; probe < GenerationTracer::kMaxTrackedNodes; probe++ )
+            {
+                TraceCounters& counters = gTraceCounters[( slot + probe ) % GenerationTracer::kMaxTrackedNodes];
+                const Generator* slotNode = counters.node.load( std::memory_order_acquire );
+
+                if( slotNode == node )
+                {
+                    return counters;
+                }
+
+                if( !slotNode )
+                {
+                    if( counters.node.compare_exchange_strong( slotNode, node, std::memory_order_acq_rel ) )
+                    {
+                        counters.metadata.store( &node->GetMetadata(), std::memory_order_relaxed );
+                        return counters;
+                    }
+
+                    if( slotNode == node )
+                    {
+                        return counters;
+                    }
+                }
+            }
+
+            return gTraceCounters[GenerationTracer::kMaxTrackedNodes];
+        }
+
+        void UpdateCounters( const GenerationCallInfo& call, uint64_t durationNs )
+        {
+            TraceCounters& counters = FindCounters( call.node );
+
+            counters.calls.fetch_add( 1, std::memory_order_relaxed );
+            counters.samples.fetch_add( call.samples, std::memory_order_relaxed );
+            counters.totalNs.fetch_add( durationNs, std::memory_order_relaxed );
+            counters.callTypeCounts[(size_t)call.type].fetch_add( 1, std::memory_order_relaxed );
+            counters.samplesHistogram[HistogramBucket( call.samples )].fetch_add( 1, std::memory_order_relaxed );
+            counters.latencyHistogram[HistogramBucket( durationNs )].fetch_add( 1, std::memory_order_relaxed );
+
+            uint64_t maxNs = counters.maxNs.load( std::memory_order_relaxed );
+            while( durationNs > maxNs && !counters.maxNs.compare_exchange_weak( maxNs, durationNs, std::memory_order_relaxed ) ) {}
+        }
+    }
+
+    bool GenerationTracer::IsAvailable()
+    {
+        return FASTNOISE_TRACING;
+    }
+
+    void GenerationTracer::SetCountersEnabled( bool enabled )
+    {
+        gCountersEnabled.store( enabled, std::memory_order_relaxed );
+    }
+
+    void GenerationTracer::SetCallbacks( BeginCallback begin, EndCallback end, void* userData )
+    {
+        // Replaced callbacks may still be in use on other threads, they are kept alive until exit
+        static std::mutex mutex;
+        static std::vector<std::unique_ptr<TraceCallbacks>> allCallbacks;
+
+        std::lock_guard lock( mutex );
+        const TraceCallbacks* callbacks = nullptr;
+
+        if( begin || end )
+        {
+            callbacks = allCallbacks.emplace_back( new TraceCallbacks{ begin, end, userData } ).get();
+        }
+
+        gTraceCallbacks.store( callbacks, std::memory_order_release );
+    }
+
+    std::vector<GenerationStats> GenerationTracer::GetSnapshot()
+    {
+        std::vector<GenerationStats> snapshot;
+
+        for( size_t i = 0; i <= kMaxTrackedNodes; i++ )
+        {
+            const TraceCounters& counters = gTraceCounters[i];
+            uint64_t calls = counters.calls.load( std::memory_order_relaxed );
+
+            if( !calls )
+            {
+                continue;
+            }
+
+            GenerationStats& stats = snapshot.emplace_back();
+            stats.node = i < kMaxTrackedNodes ? counters.node.load( std::memory_order_acquire ) : nullptr;
+            stats.metadata = counters.metadata.load( std::memory_order_relaxed );
+            stats.calls = calls;
+            stats.samples = counters.samples.load( std::memory_order_relaxed );
+            stats.totalNs = counters.totalNs.load( std::memory_order_relaxed );
+            stats.maxNs = counters.maxNs.load( std::memory_order_relaxed );
+
+            for( size_t type = 0; type < (size_t)GenerationCallType::Count; type++ )
+            {
+                stats.callTypeCounts[type] = counters.callTypeCounts[type].load( std::memory_order_relaxed );
+            }
+
+            for( size_t bucket = 0; bucket < GenerationStats::kHistogramBuckets; bucket++ )
+            {
+                stats.samplesHistogram[bucket] = counters.samplesHistogram[bucket].load( std::memory_order_relaxed );
+                stats.latencyHistogram[bucket] = counters.latencyHistogram[bucket].load( std::memory_order_relaxed );
+            }
+        }
+
+        std::sort( snapshot.begin(), snapshot.end(), []( const GenerationStats& a, const GenerationStats& b ) { return a.totalNs > b.totalNs; } );
+        return snapshot;
+    }
+
+    void GenerationTracer::Reset()
+    {
+        for( TraceCounters& counters : gTraceCounters )
+        {
+            counters.calls.store( 0, std::memory_order_relaxed );
+            counters.samples.store( 0, std::memory_order_relaxed );
+            counters.totalNs.store( 0, std::memory_order_relaxed );
+            counters.maxNs.store( 0, std::memory_order_relaxed );
+
+            for( auto& count : counters.callTypeCounts )
+            {
+                count.store( 0, std::memory_order_relaxed );
+            }
+
+            for( size_t bucket = 0; bucket < GenerationStats::kHistogramBuckets; bucket++ )
+            {
+                counters.samplesHistogram[bucket].store( 0, std::memory_order_relaxed );
+                counters.latencyHistogram[bucket].store( 0, std::memory_order_relaxed );
+            }
+
+            counters.metadata.store( nullptr, std::memory_order_relaxed );
+            counters.node.store( nullptr, std::memory_order_release );
+        }
+    }
+
+    uint64_t GenerationTracer::BeginCall( const GenerationCallInfo& call )
+    {
+        const TraceCallbacks* callbacks = gTraceCallbacks.load( std::memory_order_acquire );
+
+        if( !callbacks && !gCountersEnabled.load( std::memory_order_relaxed ) )
+        {
+            return 0;
+        }
+
+        if( callbacks && callbacks->begin )
+        {
+            callbacks->begin( call, callbacks->userData );
+        }
+
+        return std::max<uint64_t>( NowNs(), 1 );
+    }
+
+    void GenerationTracer::EndCall( const GenerationCallInfo& call, uint64_t startNs )
+    {
+        uint64_t durationNs = NowNs() - startNs;
+
+        if( gCountersEnabled.load( std::memory_order_relaxed ) )
+        {
+            UpdateCounters( call, durationNs );
+        }
+
+        const TraceCallbacks* callbacks = gTraceCallbacks.load( std::memory_order_acquire );
+
+        if( callbacks && callbacks->end )
+        {
+            callbacks->end( call, durationNs, callbacks->userData );
+        }
+    }
+} // namespace FastNoise
@@ -1,11 +1,17 @@
 #define FASTNOISE_METADATA // Should only be defined here
 
+#include <algorithm>
 #include <unordered_set>
 #include <unordered_map>
+#include <list>
+#include <iterator>
+#include <mutex>
 #include <type_traits>
 #include <limits>
 #include <cassert>
 #include <cstdint>
+#include <cstring>
+#include <cmath>
 
 #include "FastNoise/Metadata.h"
 #include "FastNoise/FastNoise.h"
@@ -21,15 +27,15 @@ constexpr static std::nullptr_t gMetadataVectorSize = nullptr; // Invalid
 // Setting these values avoids needless vector resizing and oversizing on startup
 // Sadly there is no way to automate this as they fill up as part of static init
 template<>
-constexpr size_t gMetadataVectorSize<const Metadata*> = 47;
+constexpr size_t gMetadataVectorSize<const Metadata*> = 49;
 template<>
-constexpr size_t gMetadataVectorSize<const char*> = 93;
+constexpr size_t gMetadataVectorSize<const char*> = 95;
 template<>
-constexpr size_t gMetadataVectorSize<Metadata::MemberVariable> = 93;
+constexpr size_t gMetadataVectorSize<Metadata::MemberVariable> = 104;
 template<>
-constexpr size_t gMetadataVectorSize<Metadata::MemberNodeLookup> = 32;
+constexpr size_t gMetadataVectorSize<Metadata::MemberNodeLookup> = 36;
 template<>
-constexpr size_t gMetadataVectorSize<Metadata::MemberHybrid> = 59;
+constexpr size_t gMetadataVectorSize<Metadata::MemberHybrid> = 69;
 
 template<typename T>
 static std::vector<T>& GetVectorStorage()
@@ -505,6 +511,244 @@ SmartNode<> FastNoise::NewFromEncodedNodeTree( const char* serialisedBase64NodeD
     return DeserialiseSmartNodeInternal( dataStream, referenceNodes, level );
 }
 
+static NodeData* DeserialiseNodeDataInternal( const DataStream& serialisedNodeData, std::vector<std::unique_ptr<NodeData>>& nodeDataOut );
+
+// Arena bytes for one node of this type, measured once per type and feature set by creating a node in a measuring scope
+static size_t GetArenaNodeSize( const Metadata* metadata, FastSIMD::FeatureSet level )
+{
+    static std::mutex sMutex;
+    static std::unordered_map<uint64_t, size_t> sNodeSizes;
+
+    uint64_t key = ( (uint64_t)metadata->id << 32 ) | (uint32_t)level;
+    std::lock_guard lock( sMutex );
+
+    auto find = sNodeSizes.find( key );
+    if( find != sNodeSizes.end() )
+    {
+        return find->second;
+    }
+
+    SmartNodeManager::ArenaScope measureScope( 0 );
+    metadata->CreateNode( level );
+
+    // Rounded up to the largest node alignment so sums cover any padding between nodes
+    constexpr size_t kMaxNodeAlignment = 64;
+    size_t size = ( measureScope.GetRequiredSize() + kMaxNodeAlignment - 1 ) & ~( kMaxNodeAlignment - 1 );
+
+    return sNodeSizes[key] = size;
+}
+
+static SmartNode<> DeserialiseSmartNodeInArena( const DataStream& dataStream, FastSIMD::FeatureSet level )
+{
+    size_t arenaSize = 0;
+
+    // Size the arena from the node types in the tree, nodes are only constructed once
+    {
+        std::vector<std::unique_ptr<NodeData>> nodeData;
+
+        if( !DeserialiseNodeDataInternal( dataStream, nodeData ) )
+        {
+            return nullptr;
+        }
+
+        for( const auto& node : nodeData )
+        {
+            arenaSize += GetArenaNodeSize( node->metadata, level );
+
+            // Lookups missing from older encodings are filled with constants
+            for( const NodeData* lookup : node->nodeLookups )
+            {
+                if( !lookup )
+                {
+                    arenaSize += GetArenaNodeSize( &Metadata::Get<Constant>(), level );
+                }
+            }
+        }
+    }
+
+    dataStream.nodeEndStack = 0;
+    dataStream.streamPos = 0;
+
+    // Nodes are created depth first, parents before sources, matching the Gen() evaluation order
+    SmartNodeManager::ArenaScope arenaScope( arenaSize );
+    std::vector<SmartNode<>> referenceNodes;
+
+    return DeserialiseSmartNodeInternal( dataStream, referenceNodes, level );
+}
+
+SmartNode<> FastNoise::NewFromEncodedNodeTreeInArena( const char* serialisedBase64NodeData, FastSIMD::FeatureSet level )
+{
+    DataStream dataStream = { Base64::Decode( serialisedBase64NodeData ) };
+
+    return DeserialiseSmartNodeInArena( dataStream, level );
+}
+
+SmartNode<> Metadata::CreateNodeTreeInArena( NodeData* nodeData, FastSIMD::FeatureSet level )
+{
+    std::string serialised = SerialiseNodeData( nodeData );
+
+    if( serialised.empty() )
+    {
+        return nullptr;
+    }
+
+    return FastNoise::NewFromEncodedNodeTreeInArena( serialised.c_str(), level );
+}
+
+namespace
+{
+    // LRU cache of deserialised node trees, most recently used at the front of the list
+    class EncodedNodeTreeCache
+    {
+    public:
+        SmartNode<const Generator> Get( const char* encodedString, FastSIMD::FeatureSet level )
+        {
+            Key key = { encodedString, level };
+
+            {
+                std::lock_guard lock( mMutex );
+
+                auto find = mLookup.find( key );
+                if( find != mLookup.end() )
+                {
+                    mStats.hits++;
+                    mEntries.splice( mEntries.begin(), mEntries, find->second );
+                    return find->second->node;
+                }
+                mStats.misses++;
+            }
+
+            // Deserialise outside the lock, concurrent misses on the same key keep the first inserted tree
+            SmartNode<const Generator> node = NewFromEncodedNodeTree( encodedString, level );
+
+            if( !node )
+            {
+                return node;
+            }
+
+            // Declared before the lock so evicted trees are released after it is unlocked
+            std::list<Entry> evicted;
+            std::lock_guard lock( mMutex );
+
+            auto find = mLookup.find( key );
+            if( find != mLookup.end() )
+            {
+                mEntries.splice( mEntries.begin(), mEntries, find->second );
+                return find->second->node;
+            }
+
+            if( mStats.capacity == 0 )
+            {
+                return node;
+            }
+
+            mEntries.push_front( { key, node } );
+            mLookup.emplace( std::move( key ), mEntries.begin() );
+            Trim( evicted );
+
+            return node;
+        }
+
+        void SetCapacity( size_t capacity )
+        {
+            std::list<Entry> evicted;
+            std::lock_guard lock( mMutex );
+
+            mStats.capacity = capacity;
+            Trim( evicted );
+        }
+
+        EncodedNodeTreeCacheStats GetStats()
+        {
+            std::lock_guard lock( mMutex );
+
+            EncodedNodeTreeCacheStats stats = mStats;
+            stats.size = mEntries.size();
+            return stats;
+        }
+
+        void Clear()
+        {
+            std::list<Entry> cleared;
+            std::lock_guard lock( mMutex );
+
+            mLookup.clear();
+            cleared.swap( mEntries );
+            mStats = { 0, 0, 0, 0, mStats.capacity };
+        }
+
+    private:
+        struct Key
+        {
+            std::string encodedString;
+            FastSIMD::FeatureSet level;
+
+            bool operator==( const Key& rhs ) const
+            {
+                return level == rhs.level && encodedString == rhs.encodedString;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()( const Key& key ) const noexcept
+            {
+                return std::hash<std::string>()( key.encodedString ) ^ ( (size_t)key.level * 0x9E3779B97F4A7C15ull );
+            }
+        };
+
+        struct Entry
+        {
+            Key key;
+            SmartNode<const Generator> node;
+        };
+
+        // Moves least recently used entries to evicted, the caller releases them outside the lock
+        void Trim( std::list<Entry>& evicted )
+        {
+            while( mEntries.size() > mStats.capacity )
+            {
+                mLookup.erase( mEntries.back().key );
+                evicted.splice( evicted.end(), mEntries, std::prev( mEntries.end() ) );
+                mStats.evictions++;
+            }
+        }
+
+        static constexpr size_t kDefaultCapacity = 64;
+
+        std::mutex mMutex;
+        std::list<Entry> mEntries;
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> mLookup;
+        EncodedNodeTreeCacheStats mStats = { 0, 0, 0, 0, kDefaultCapacity };
+    };
+
+    EncodedNodeTreeCache& GetEncodedNodeTreeCache()
+    {
+        static EncodedNodeTreeCache cache;
+        return cache;
+    }
+}
+
+SmartNode<const Generator> FastNoise::NewFromEncodedNodeTreeCached( const char* serialisedBase64NodeData, FastSIMD::FeatureSet level )
+{
+    return GetEncodedNodeTreeCache().Get( serialisedBase64NodeData, level );
+}
+
+void FastNoise::SetEncodedNodeTreeCacheCapacity( size_t capacity )
+{
+    GetEncodedNodeTreeCache().SetCapacity( capacity );
+}
+
+EncodedNodeTreeCacheStats FastNoise::GetEncodedNodeTreeCacheStats()
+{
+    return GetEncodedNodeTreeCache().GetStats();
+}
+
+void FastNoise::ClearEncodedNodeTreeCache()
+{
+    GetEncodedNodeTreeCache().Clear();
+}
+
 static NodeData* DeserialiseNodeDataInternal( const DataStream& serialisedNodeData, std::vector<std::unique_ptr<NodeData>>& nodeDataOut )
 {
     Metadata::node_id nodeId;
@@ -631,6 +875,1518 @@ NodeData* Metadata::DeserialiseNodeData( const char* serialisedBase64NodeData, s
     return DeserialiseNodeDataInternal( dataStream, nodeDataOut );
 }
 
+namespace BinaryNodeTree
+{
+    static constexpr uint32_t kMagic = 0x54424E46; // "FNBT"
+    static constexpr uint16_t kVersion = 1;
+
+    struct Header
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t nodeCount;
+        uint32_t paramCount;
+        uint32_t totalSize;
+    };
+
+    // Nodes are stored children first, the root is the last node
+    struct Node
+    {
+        Metadata::node_id nodeId;
+        uint8_t reserved;
+        uint16_t paramCount;
+        uint32_t firstParam;
+    };
+
+    struct Param
+    {
+        enum Type : uint8_t
+        {
+            Variable,
+            Lookup,
+            HybridValue,
+            HybridLookup,
+        };
+
+        Type type;
+        uint8_t memberIndex;
+        uint16_t reserved;
+        uint32_t value; // Variable/float bits or index of an earlier node
+    };
+
+    static_assert( sizeof( Header ) == 16 && sizeof( Node ) == 8 && sizeof( Param ) == 8, "Binary node tree layout must stay fixed" );
+
+    // Records are stored little endian, fields are byte swapped on big endian hosts
+    static bool IsBigEndianHost()
+    {
+        const uint16_t probe = 1;
+        uint8_t firstByte;
+        std::memcpy( &firstByte, &probe, 1 );
+        return firstByte == 0;
+    }
+
+    static uint16_t SwapBytes( uint16_t v )
+    {
+        return (uint16_t)( ( v >> 8 ) | ( v << 8 ) );
+    }
+
+    static uint32_t SwapBytes( uint32_t v )
+    {
+        return ( v >> 24 ) | ( ( v >> 8 ) & 0xFF00 ) | ( ( v << 8 ) & 0xFF0000 ) | ( v << 24 );
+    }
+
+    static void SwapBytes( Header& header )
+    {
+        header.magic = SwapBytes( header.magic );
+        header.version = SwapBytes( header.version );
+        header.nodeCount = SwapBytes( header.nodeCount );
+        header.paramCount = SwapBytes( header.paramCount );
+        header.totalSize = SwapBytes( header.totalSize );
+    }
+
+    static void SwapBytes( Node& node )
+    {
+        node.paramCount = SwapBytes( node.paramCount );
+        node.firstParam = SwapBytes( node.firstParam );
+    }
+
+    static void SwapBytes( Param& param )
+    {
+        param.reserved = SwapBytes( param.reserved );
+        param.value = SwapBytes( param.value );
+    }
+
+    // Reads a record from the buffer without requiring alignment, false if out of bounds
+    template<typename T>
+    static bool Read( const uint8_t* data, size_t size, size_t offset, T& value )
+    {
+        if( offset > size || size - offset < sizeof( T ) )
+        {
+            return false;
+        }
+
+        std::memcpy( &value, data + offset, sizeof( T ) );
+
+        if( IsBigEndianHost() )
+        {
+            SwapBytes( value );
+        }
+        return true;
+    }
+
+    template<typename T>
+    static void Write( std::vector<uint8_t>& buffer, T value )
+    {
+        if( IsBigEndianHost() )
+        {
+            SwapBytes( value );
+        }
+
+        size_t offset = buffer.size();
+        buffer.resize( offset + sizeof( T ) );
+        std::memcpy( buffer.data() + offset, &value, sizeof( T ) );
+    }
+
+    static bool AddNode( const NodeData* nodeData, std::vector<Node>& nodes, std::vector<Param>& params, std::unordered_map<const NodeData*, uint32_t>& nodeIndices, std::unordered_set<const NodeData*>& dependencies )
+    {
+        if( nodeIndices.find( nodeData ) != nodeIndices.end() )
+        {
+            return true;
+        }
+
+        const Metadata* metadata = nodeData->metadata;
+
+        if( !metadata ||
+            nodeData->variables.size() != metadata->memberVariables.size() ||
+            nodeData->nodeLookups.size() != metadata->memberNodeLookups.size() ||
+            nodeData->hybrids.size() != metadata->memberHybrids.size() )
+        {
+            assert( 0 ); // Member size mismatch with metadata
+            return false;
+        }
+
+        // Dependency loop
+        if( !dependencies.insert( nodeData ).second )
+        {
+            return false;
+        }
+
+        for( const NodeData* source : nodeData->nodeLookups )
+        {
+            if( !source || !AddNode( source, nodes, params, nodeIndices, dependencies ) )
+            {
+                return false;
+            }
+        }
+
+        for( const auto& hybrid : nodeData->hybrids )
+        {
+            if( hybrid.first && !AddNode( hybrid.first, nodes, params, nodeIndices, dependencies ) )
+            {
+                return false;
+            }
+        }
+
+        dependencies.erase( nodeData );
+
+        if( nodes.size() >= std::numeric_limits<uint16_t>::max() )
+        {
+            return false;
+        }
+
+        Node node = { metadata->id, 0, 0, (uint32_t)params.size() };
+
+        // All values are written, including defaults, so a default changed in a later version does not change stored trees
+        for( size_t i = 0; i < metadata->memberVariables.size(); i++ )
+        {
+            params.push_back( { Param::Variable, (uint8_t)i, 0, (uint32_t)nodeData->variables[i].i } );
+        }
+
+        for( size_t i = 0; i < metadata->memberNodeLookups.size(); i++ )
+        {
+            params.push_back( { Param::Lookup, (uint8_t)i, 0, nodeIndices[nodeData->nodeLookups[i]] } );
+        }
+
+        for( size_t i = 0; i < metadata->memberHybrids.size(); i++ )
+        {
+            if( nodeData->hybrids[i].first )
+            {
+                params.push_back( { Param::HybridLookup, (uint8_t)i, 0, nodeIndices[nodeData->hybrids[i].first] } );
+            }
+            else
+            {
+                Metadata::MemberVariable::ValueUnion v = nodeData->hybrids[i].second;
+
+                params.push_back( { Param::HybridValue, (uint8_t)i, 0, (uint32_t)v.i } );
+            }
+        }
+
+        node.paramCount = (uint16_t)( params.size() - node.firstParam );
+
+        nodeIndices.emplace( nodeData, (uint32_t)nodes.size() );
+        nodes.push_back( node );
+        return true;
+    }
+}
+
+std::vector<uint8_t> Metadata::SerialiseNodeDataBinary( NodeData* nodeData, bool fixUp )
+{
+    using namespace BinaryNodeTree;
+
+    // Reuse the encoded string path to apply fix ups to the node data
+    if( fixUp && SerialiseNodeData( nodeData, true ).empty() )
+    {
+        return {};
+    }
+
+    std::vector<Node> nodes;
+    std::vector<Param> params;
+    std::unordered_map<const NodeData*, uint32_t> nodeIndices;
+    std::unordered_set<const NodeData*> dependencies;
+
+    if( !nodeData || !AddNode( nodeData, nodes, params, nodeIndices, dependencies ) )
+    {
+        return {};
+    }
+
+    Header header;
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.nodeCount = (uint16_t)nodes.size();
+    header.paramCount = (uint32_t)params.size();
+    header.totalSize = (uint32_t)( sizeof( Header ) + nodes.size() * sizeof( Node ) + params.size() * sizeof( Param ) );
+
+    std::vector<uint8_t> buffer;
+    buffer.reserve( header.totalSize );
+
+    Write( buffer, header );
+    for( const Node& node : nodes )
+    {
+        Write( buffer, node );
+    }
+    for( const Param& param : params )
+    {
+        Write( buffer, param );
+    }
+
+    return buffer;
+}
+
+SmartNode<> FastNoise::NewFromBinaryNodeTree( const void* binaryNodeTree, size_t size, FastSIMD::FeatureSet level )
+{
+    using namespace BinaryNodeTree;
+
+    const uint8_t* data = static_cast<const uint8_t*>( binaryNodeTree );
+    Header header;
+
+    if( !data || !Read( data, size, 0, header ) ||
+        header.magic != kMagic || header.version != kVersion ||
+        header.nodeCount == 0 || header.totalSize > size ||
+        header.totalSize != sizeof( Header ) + (size_t)header.nodeCount * sizeof( Node ) + (size_t)header.paramCount * sizeof( Param ) )
+    {
+        return nullptr;
+    }
+
+    const size_t nodeTableOffset = sizeof( Header );
+    const size_t paramBlockOffset = nodeTableOffset + (size_t)header.nodeCount * sizeof( Node );
+
+    std::vector<SmartNode<>> generators;
+    generators.reserve( header.nodeCount );
+
+    for( size_t nodeIdx = 0; nodeIdx < header.nodeCount; nodeIdx++ )
+    {
+        Node node;
+        if( !Read( data, header.totalSize, nodeTableOffset + nodeIdx * sizeof( Node ), node ) ||
+            (size_t)node.firstParam + node.paramCount > header.paramCount )
+        {
+            return nullptr;
+        }
+
+        const Metadata* metadata = Metadata::GetFromId( node.nodeId );
+        if( !metadata )
+        {
+            return nullptr;
+        }
+
+        SmartNode<> generator = metadata->CreateNode( level );
+        if( !generator )
+        {
+            return nullptr;
+        }
+
+        uint64_t lookupsSet = 0;
+
+        for( size_t paramIdx = node.firstParam; paramIdx < (size_t)node.firstParam + node.paramCount; paramIdx++ )
+        {
+            Param param;
+            if( !Read( data, header.totalSize, paramBlockOffset + paramIdx * sizeof( Param ), param ) )
+            {
+                return nullptr;
+            }
+
+            Metadata::MemberVariable::ValueUnion v = (int)param.value;
+
+            switch( param.type )
+            {
+            case Param::Variable:
+                // Members unknown to this version are skipped, matching the encoded string format
+                if( param.memberIndex < metadata->memberVariables.size() )
+                {
+                    metadata->memberVariables[param.memberIndex].setFunc( generator.get(), v );
+                }
+                break;
+
+            case Param::Lookup:
+                // Sources must reference an earlier node, this also prevents loops
+                if( param.value >= nodeIdx )
+                {
+                    return nullptr;
+                }
+                if( param.memberIndex < metadata->memberNodeLookups.size() )
+                {
+                    if( !metadata->memberNodeLookups[param.memberIndex].setFunc( generator.get(), generators[param.value] ) )
+                    {
+                        return nullptr;
+                    }
+                    lookupsSet |= (uint64_t)1 << param.memberIndex;
+                }
+                break;
+
+            case Param::HybridValue:
+                if( param.memberIndex < metadata->memberHybrids.size() )
+                {
+                    metadata->memberHybrids[param.memberIndex].setValueFunc( generator.get(), v.f );
+                }
+                break;
+
+            case Param::HybridLookup:
+                if( param.value >= nodeIdx )
+                {
+                    return nullptr;
+                }
+                if( param.memberIndex < metadata->memberHybrids.size() )
+                {
+                    if( !metadata->memberHybrids[param.memberIndex].setNodeFunc( generator.get(), generators[param.value] ) )
+                    {
+                        return nullptr;
+                    }
+                }
+                break;
+
+            default:
+                return nullptr;
+            }
+        }
+
+        for( size_t i = 0; i < metadata->memberNodeLookups.size(); i++ )
+        {
+            // Attempt to use a dummy node to fill node lookups added after the tree was serialised
+            if( !( lookupsSet & ( (uint64_t)1 << i ) ) &&
+                !metadata->memberNodeLookups[i].setFunc( generator.get(), FastNoise::New<FastNoise::Constant>( level ) ) )
+            {
+                return nullptr;
+            }
+        }
+
+        generators.emplace_back( std::move( generator ) );
+    }
+
+    return generators.back();
+}
+
+namespace StructuralHash
+{
+    static uint64_t Mix( uint64_t hash, uint64_t value )
+    {
+        hash ^= value + 0x9E3779B97F4A7C15ull + ( hash << 6 ) + ( hash >> 2 );
+        hash ^= hash >> 31;
+        hash *= 0xBF58476D1CE4E5B9ull;
+        hash ^= hash >> 27;
+        return hash;
+    }
+
+    // FNV-1a, node types are hashed by name so hashes don't depend on registration order
+    static uint64_t HashString( const char* string )
+    {
+        uint64_t hash = 0xCBF29CE484222325ull;
+
+        while( *string )
+        {
+            hash ^= (uint8_t)*string++;
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    // -0.0 == 0.0 and all NaNs are the same value
+    static uint32_t CanonicalFloatBits( float value )
+    {
+        if( value == 0.0f )
+        {
+            return 0;
+        }
+        if( value != value )
+        {
+            return 0x7FC00000;
+        }
+
+        uint32_t bits;
+        std::memcpy( &bits, &value, sizeof( bits ) );
+        return bits;
+    }
+
+    static uint32_t CanonicalVariable( const Metadata::MemberVariable& member, Metadata::MemberVariable::ValueUnion value )
+    {
+        return member.type == Metadata::MemberVariable::EFloat ? CanonicalFloatBits( value.f ) : (uint32_t)value.i;
+    }
+
+    static bool HasCommutativeOperands( const NodeData* nodeData )
+    {
+        return nodeData->metadata->commutativeOperands && !nodeData->nodeLookups.empty() && !nodeData->hybrids.empty();
+    }
+
+    class Hasher
+    {
+    public:
+        bool valid = true;
+
+        uint64_t Hash( const NodeData* nodeData )
+        {
+            if( !nodeData || !nodeData->metadata )
+            {
+                return kNullHash;
+            }
+
+            auto find = mHashes.find( nodeData );
+            if( find != mHashes.end() )
+            {
+                return find->second;
+            }
+
+            if( !mDependencies.insert( nodeData ).second )
+            {
+                valid = false; // Loop
+                return 0;
+            }
+
+            const Metadata* metadata = nodeData->metadata;
+            uint64_t hash = HashString( metadata->name );
+
+            for( size_t i = 0; i < nodeData->variables.size() && i < metadata->memberVariables.size(); i++ )
+            {
+                hash = Mix( hash, CanonicalVariable( metadata->memberVariables[i], nodeData->variables[i] ) );
+            }
+
+            size_t firstLookup = 0;
+            size_t firstHybrid = 0;
+
+            if( HasCommutativeOperands( nodeData ) )
+            {
+                uint64_t lhs = Hash( nodeData->nodeLookups[0] );
+                uint64_t rhs = HashHybrid( nodeData->hybrids[0] );
+
+                hash = Mix( hash, std::min( lhs, rhs ) );
+                hash = Mix( hash, std::max( lhs, rhs ) );
+                firstLookup = firstHybrid = 1;
+            }
+
+            for( size_t i = firstLookup; i < nodeData->nodeLookups.size(); i++ )
+            {
+                hash = Mix( hash, Hash( nodeData->nodeLookups[i] ) );
+            }
+
+            for( size_t i = firstHybrid; i < nodeData->hybrids.size(); i++ )
+            {
+                hash = Mix( hash, HashHybrid( nodeData->hybrids[i] ) );
+            }
+
+            mDependencies.erase( nodeData );
+            mHashes.emplace( nodeData, hash );
+            return hash;
+        }
+
+    private:
+        static constexpr uint64_t kNullHash = 0x6E756C6C6E6F6465ull;
+        static constexpr uint64_t kConstantTag = 0x636F6E7374616E74ull;
+
+        // The constant is unused while a node is connected
+        uint64_t HashHybrid( const std::pair<NodeData*, float>& hybrid )
+        {
+            if( hybrid.first )
+            {
+                return Hash( hybrid.first );
+            }
+
+            return Mix( kConstantTag, CanonicalFloatBits( hybrid.second ) );
+        }
+
+        std::unordered_map<const NodeData*, uint64_t> mHashes;
+        std::unordered_set<const NodeData*> mDependencies;
+    };
+
+    class Comparer
+    {
+    public:
+        bool Equal( const NodeData* lhs, const NodeData* rhs )
+        {
+            if( lhs == rhs )
+            {
+                return true;
+            }
+
+            if( !lhs || !rhs || lhs->metadata != rhs->metadata || !lhs->metadata ||
+                lhs->variables.size() != rhs->variables.size() ||
+                lhs->nodeLookups.size() != rhs->nodeLookups.size() ||
+                lhs->hybrids.size() != rhs->hybrids.size() )
+            {
+                return false;
+            }
+
+            NodePair pair{ lhs, rhs };
+
+            if( mEqual.count( pair ) )
+            {
+                return true;
+            }
+
+            // Loops are never equal
+            if( !mInProgress.insert( pair ).second )
+            {
+                return false;
+            }
+
+            bool equal = EqualMembers( lhs, rhs );
+
+            mInProgress.erase( pair );
+
+            if( equal )
+            {
+                mEqual.insert( pair );
+            }
+            return equal;
+        }
+
+    private:
+        using NodePair = std::pair<const NodeData*, const NodeData*>;
+
+        struct NodePairHash
+        {
+            size_t operator()( const NodePair& pair ) const noexcept
+            {
+                return std::hash<const void*>()( pair.first ) ^ ( std::hash<const void*>()( pair.second ) * 31 );
+            }
+        };
+
+        bool EqualMembers( const NodeData* lhs, const NodeData* rhs )
+        {
+            const Metadata* metadata = lhs->metadata;
+
+            for( size_t i = 0; i < lhs->variables.size() && i < metadata->memberVariables.size(); i++ )
+            {
+                if( CanonicalVariable( metadata->memberVariables[i], lhs->variables[i] ) !=
+                    CanonicalVariable( metadata->memberVariables[i], rhs->variables[i] ) )
+                {
+                    return false;
+                }
+            }
+
+            size_t firstOperand = 0;
+
+            if( HasCommutativeOperands( lhs ) )
+            {
+                const auto& lhsHybrid = lhs->hybrids[0];
+                const auto& rhsHybrid = rhs->hybrids[0];
+
+                bool inOrder = Equal( lhs->nodeLookups[0], rhs->nodeLookups[0] ) && EqualHybrid( lhsHybrid, rhsHybrid );
+
+                if( !inOrder &&
+                    !( lhsHybrid.first && rhsHybrid.first &&
+                       Equal( lhs->nodeLookups[0], rhsHybrid.first ) && Equal( lhsHybrid.first, rhs->nodeLookups[0] ) ) )
+                {
+                    return false;
+                }
+                firstOperand = 1;
+            }
+
+            for( size_t i = firstOperand; i < lhs->nodeLookups.size(); i++ )
+            {
+                if( !Equal( lhs->nodeLookups[i], rhs->nodeLookups[i] ) )
+                {
+                    return false;
+                }
+            }
+
+            for( size_t i = firstOperand; i < lhs->hybrids.size(); i++ )
+            {
+                if( !EqualHybrid( lhs->hybrids[i], rhs->hybrids[i] ) )
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool EqualHybrid( const std::pair<NodeData*, float>& lhs, const std::pair<NodeData*, float>& rhs )
+        {
+            if( lhs.first || rhs.first )
+            {
+                return lhs.first && rhs.first && Equal( lhs.first, rhs.first );
+            }
+
+            return CanonicalFloatBits( lhs.second ) == CanonicalFloatBits( rhs.second );
+        }
+
+        std::unordered_set<NodePair, NodePairHash> mEqual;
+        std::unordered_set<NodePair, NodePairHash> mInProgress;
+    };
+} // namespace StructuralHash
+
+uint64_t Metadata::HashNodeData( const NodeData* nodeData )
+{
+    StructuralHash::Hasher hasher;
+    uint64_t hash = hasher.Hash( nodeData );
+
+    return hasher.valid ? hash : 0;
+}
+
+bool Metadata::NodeDataStructurallyEqual( const NodeData* lhs, const NodeData* rhs )
+{
+    // Rejects loops before comparing, the comparer treats a node as equal to itself without walking it
+    // Equal trees always hash equal, so differing hashes are also an early out
+    StructuralHash::Hasher hasher;
+    uint64_t lhsHash = hasher.Hash( lhs );
+    uint64_t rhsHash = hasher.Hash( rhs );
+
+    if( !hasher.valid || lhsHash != rhsHash )
+    {
+        return false;
+    }
+
+    StructuralHash::Comparer comparer;
+
+    return comparer.Equal( lhs, rhs );
+}
+
+namespace NodeDataSimplify
+{
+    class Simplifier
+    {
+    public:
+        Simplifier( std::vector<std::unique_ptr<NodeData>>& nodeDataOut, std::vector<std::string>* changesOut ) :
+            mNodeDataOut( nodeDataOut ), mChangesOut( changesOut )
+        { }
+
+        // Returns the node that replaces nodeData, sources are simplified first so chains collapse bottom up
+        NodeData* Simplify( NodeData* nodeData )
+        {
+            if( !nodeData || !nodeData->metadata )
+            {
+                return nodeData;
+            }
+
+            auto find = mReplacements.find( nodeData );
+            if( find != mReplacements.end() )
+            {
+                return find->second;
+            }
+
+            // Leave loops untouched
+            if( !mInProgress.insert( nodeData ).second )
+            {
+                return nodeData;
+            }
+
+            for( NodeData*& source : nodeData->nodeLookups )
+            {
+                source = Simplify( source );
+            }
+
+            for( auto& hybrid : nodeData->hybrids )
+            {
+                hybrid.first = Simplify( hybrid.first );
+
+                float value;
+                if( GetConstant( hybrid.first, value ) )
+                {
+                    hybrid = { nullptr, value };
+                    Report( nodeData, "inlined Constant source into hybrid input" );
+                }
+            }
+
+            NodeData* replacement = SimplifyNode( nodeData );
+
+            mInProgress.erase( nodeData );
+            mReplacements.emplace( nodeData, replacement );
+            return replacement;
+        }
+
+    private:
+        template<typename T>
+        static bool Is( const NodeData* nodeData )
+        {
+            return nodeData && nodeData->metadata == &Metadata::Get<T>();
+        }
+
+        static bool GetConstant( const NodeData* nodeData, float& value )
+        {
+            if( Is<Constant>( nodeData ) )
+            {
+                value = nodeData->variables[0].f;
+                return true;
+            }
+            return false;
+        }
+
+        static bool GetConstant( const std::pair<NodeData*, float>& hybrid, float& value )
+        {
+            if( !hybrid.first )
+            {
+                value = hybrid.second;
+                return true;
+            }
+            return GetConstant( hybrid.first, value );
+        }
+
+        static bool AllConstant( const NodeData* nodeData, float value )
+        {
+            for( const auto& hybrid : nodeData->hybrids )
+            {
+                if( hybrid.first || hybrid.second != value )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static bool AllHybridsConstant( const NodeData* nodeData )
+        {
+            for( const auto& hybrid : nodeData->hybrids )
+            {
+                if( hybrid.first )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void Report( const NodeData* nodeData, const char* change )
+        {
+            if( mChangesOut )
+            {
+                mChangesOut->emplace_back( std::string( nodeData->metadata->name ) + ": " + change );
+            }
+        }
+
+        NodeData* NewConstant( float value )
+        {
+            NodeData* constant = mNodeDataOut.emplace_back( new NodeData( &Metadata::Get<Constant>() ) ).get();
+            constant->variables[0] = value;
+            return constant;
+        }
+
+        template<typename F>
+        NodeData* FoldOperator( NodeData* nodeData, float lhs, float rhs, F&& op )
+        {
+            Report( nodeData, "folded constant operands into Constant" );
+            return NewConstant( op( lhs, rhs ) );
+        }
+
+        NodeData* SimplifyNode( NodeData* nodeData )
+        {
+            float lhs, rhs;
+
+            if( Is<Add>( nodeData ) || Is<Multiply>( nodeData ) )
+            {
+                bool isAdd = Is<Add>( nodeData );
+                float identity = isAdd ? 0.0f : 1.0f;
+                bool lhsConstant = GetConstant( nodeData->nodeLookups[0], lhs );
+                bool rhsConstant = GetConstant( nodeData->hybrids[0], rhs );
+
+                if( lhsConstant && rhsConstant )
+                {
+                    return FoldOperator( nodeData, lhs, rhs, [isAdd]( float a, float b ) { return isAdd ? a + b : a * b; } );
+                }
+                if( rhsConstant && rhs == identity && nodeData->nodeLookups[0] )
+                {
+                    Report( nodeData, isAdd ? "removed add of 0" : "removed multiply by 1" );
+                    return nodeData->nodeLookups[0];
+                }
+                if( lhsConstant && lhs == identity && nodeData->hybrids[0].first )
+                {
+                    Report( nodeData, isAdd ? "removed add of 0" : "removed multiply by 1" );
+                    return nodeData->hybrids[0].first;
+                }
+            }
+            else if( Is<Min>( nodeData ) || Is<Max>( nodeData ) )
+            {
+                if( GetConstant( nodeData->nodeLookups[0], lhs ) && GetConstant( nodeData->hybrids[0], rhs ) )
+                {
+                    bool isMin = Is<Min>( nodeData );
+                    return FoldOperator( nodeData, lhs, rhs, [isMin]( float a, float b ) { return isMin ? std::min( a, b ) : std::max( a, b ); } );
+                }
+            }
+            else if( Is<Subtract>( nodeData ) || Is<Divide>( nodeData ) )
+            {
+                bool isSubtract = Is<Subtract>( nodeData );
+                bool lhsConstant = GetConstant( nodeData->hybrids[0], lhs );
+                bool rhsConstant = GetConstant( nodeData->hybrids[1], rhs );
+
+                if( lhsConstant && rhsConstant )
+                {
+                    return FoldOperator( nodeData, lhs, rhs, [isSubtract]( float a, float b ) { return isSubtract ? a - b : a / b; } );
+                }
+                if( rhsConstant && rhs == ( isSubtract ? 0.0f : 1.0f ) && nodeData->hybrids[0].first )
+                {
+                    Report( nodeData, isSubtract ? "removed subtract of 0" : "removed divide by 1" );
+                    return nodeData->hybrids[0].first;
+                }
+            }
+            else if( Is<DomainScale>( nodeData ) )
+            {
+                NodeData* source = nodeData->nodeLookups[0];
+
+                if( nodeData->variables[0].f == 1.0f && source )
+                {
+                    Report( nodeData, "removed scale of 1" );
+                    return source;
+                }
+                if( Is<DomainScale>( source ) )
+                {
+                    Report( nodeData, "merged nested DomainScale" );
+                    nodeData->variables[0] = nodeData->variables[0].f * source->variables[0].f;
+                    nodeData->nodeLookups[0] = source->nodeLookups[0];
+                    return SimplifyNode( nodeData );
+                }
+                if( Is<DomainAxisScale>( source ) )
+                {
+                    Report( nodeData, "merged into nested DomainAxisScale" );
+                    NodeData* axisScale = mNodeDataOut.emplace_back( new NodeData( *source ) ).get();
+
+                    for( auto& scale : axisScale->variables )
+                    {
+                        scale = scale.f * nodeData->variables[0].f;
+                    }
+                    return SimplifyNode( axisScale );
+                }
+            }
+            else if( Is<DomainAxisScale>( nodeData ) )
+            {
+                NodeData* source = nodeData->nodeLookups[0];
+                bool identity = true;
+
+                for( auto& scale : nodeData->variables )
+                {
+                    identity &= scale.f == 1.0f;
+                }
+
+                if( identity && source )
+                {
+                    Report( nodeData, "removed scale of 1" );
+                    return source;
+                }
+                if( Is<DomainAxisScale>( source ) || Is<DomainScale>( source ) )
+                {
+                    Report( nodeData, Is<DomainScale>( source ) ? "merged nested DomainScale" : "merged nested DomainAxisScale" );
+
+                    for( size_t i = 0; i < nodeData->variables.size(); i++ )
+                    {
+                        nodeData->variables[i] = nodeData->variables[i].f * source->variables[Is<DomainScale>( source ) ? 0 : i].f;
+                    }
+                    nodeData->nodeLookups[0] = source->nodeLookups[0];
+                    return SimplifyNode( nodeData );
+                }
+            }
+            else if( Is<DomainOffset>( nodeData ) )
+            {
+                NodeData* source = nodeData->nodeLookups[0];
+
+                if( AllConstant( nodeData, 0.0f ) && source )
+                {
+                    Report( nodeData, "removed offset of 0" );
+                    return source;
+                }
+                if( Is<DomainOffset>( source ) && AllHybridsConstant( nodeData ) && AllHybridsConstant( source ) )
+                {
+                    Report( nodeData, "merged nested DomainOffset" );
+
+                    for( size_t i = 0; i < nodeData->hybrids.size(); i++ )
+                    {
+                        nodeData->hybrids[i].second += source->hybrids[i].second;
+                    }
+                    nodeData->nodeLookups[0] = source->nodeLookups[0];
+                    return SimplifyNode( nodeData );
+                }
+            }
+            else if( Is<SeedOffset>( nodeData ) )
+            {
+                NodeData* source = nodeData->nodeLookups[0];
+
+                if( nodeData->variables[0].i == 0 && source )
+                {
+                    Report( nodeData, "removed seed offset of 0" );
+                    return source;
+                }
+                if( Is<SeedOffset>( source ) )
+                {
+                    Report( nodeData, "merged nested SeedOffset" );
+                    nodeData->variables[0] = (int)( (uint32_t)nodeData->variables[0].i + (uint32_t)source->variables[0].i );
+                    nodeData->nodeLookups[0] = source->nodeLookups[0];
+                    return SimplifyNode( nodeData );
+                }
+            }
+            else if( Is<Remap>( nodeData ) )
+            {
+                NodeData* source = nodeData->nodeLookups[0];
+
+                if( AllHybridsConstant( nodeData ) && nodeData->variables[0].i == (int)Boolean::False && source &&
+                    nodeData->hybrids[0].second == nodeData->hybrids[2].second &&
+                    nodeData->hybrids[1].second == nodeData->hybrids[3].second &&
+                    nodeData->hybrids[0].second != nodeData->hybrids[1].second )
+                {
+                    Report( nodeData, "removed identity remap" );
+                    return source;
+                }
+            }
+
+            return nodeData;
+        }
+
+        std::vector<std::unique_ptr<NodeData>>& mNodeDataOut;
+        std::vector<std::string>* mChangesOut;
+        std::unordered_map<NodeData*, NodeData*> mReplacements;
+        std::unordered_set<NodeData*> mInProgress;
+    };
+} // namespace NodeDataSimplify
+
+NodeData* Metadata::SimplifyNodeData( NodeData* nodeData, std::vector<std::unique_ptr<NodeData>>& nodeDataOut, std::vector<std::string>* changesOut )
+{
+    NodeDataSimplify::Simplifier simplifier( nodeDataOut, changesOut );
+
+    return simplifier.Simplify( nodeData );
+}
+
+std::string Metadata::SimplifyEncodedNodeTree( const char* serialisedBase64NodeData, std::vector<std::string>* changesOut )
+{
+    std::vector<std::unique_ptr<NodeData>> nodeDataOut;
+    NodeData* nodeData = DeserialiseNodeData( serialisedBase64NodeData, nodeDataOut );
+
+    if( !nodeData )
+    {
+        return "";
+    }
+
+    return SerialiseNodeData( SimplifyNodeData( nodeData, nodeDataOut, changesOut ) );
+}
+
+namespace NodeDataSpecialize
+{
+    using OutputMap = std::unordered_map<const NodeData*, std::vector<float>>;
+
+    template<typename T>
+    static bool Is( const NodeData* nodeData )
+    {
+        return nodeData && nodeData->metadata == &Metadata::Get<T>();
+    }
+
+    // Node types that evaluate all their sources at their own positions and seed
+    // Node lookups of any other node see transformed inputs (domain modifier, seed offset, fractal and warp sources, cellular lookups)
+    static bool PassesInputsToSources( const NodeData* nodeData )
+    {
+        return Is<Add>( nodeData ) || Is<Subtract>( nodeData ) || Is<Multiply>( nodeData ) || Is<Divide>( nodeData ) ||
+               Is<Modulus>( nodeData ) || Is<PowFloat>( nodeData ) || Is<PowInt>( nodeData ) || Is<Min>( nodeData ) ||
+               Is<Max>( nodeData ) || Is<MinSmooth>( nodeData ) || Is<MaxSmooth>( nodeData ) || Is<Fade>( nodeData ) ||
+               Is<Select>( nodeData ) || Is<Switch>( nodeData ) || Is<Abs>( nodeData ) || Is<SignedSquareRoot>( nodeData ) ||
+               Is<Remap>( nodeData ) || Is<Terrace>( nodeData ) || Is<ConvertRGBA8>( nodeData ) || Is<PingPong>( nodeData ) ||
+               Is<GeneratorCache>( nodeData );
+    }
+
+    // Hybrids are evaluated at the node's own positions and seed (fractal gain, warp amplitude, cellular jitter)
+    // except Minkowski P, which cellular and distance nodes evaluate at the distance to each point
+    static bool TransformsHybridInputs( const NodeData* nodeData, size_t hybridIdx )
+    {
+        const auto& memberHybrids = nodeData->metadata->memberHybrids;
+
+        return !PassesInputsToSources( nodeData ) && hybridIdx < memberHybrids.size() &&
+               std::strcmp( memberHybrids[hybridIdx].name, "Minkowski P" ) == 0;
+    }
+
+    // Generates every region with the node as the root, outputs are concatenated in region order
+    // Only matches the values seen inside the full tree for nodes with no input transforming ancestor
+    static bool GenerateRegions( NodeData* nodeData, const std::vector<NodeDataProfileRegion>& regions, FastSIMD::FeatureSet level, std::vector<float>& output )
+    {
+        SmartNode<> generator = Metadata::CreateNodeTreeInArena( nodeData, level );
+
+        if( !generator )
+        {
+            return false;
+        }
+
+        for( const NodeDataProfileRegion& region : regions )
+        {
+            if( region.dimensions < 2 || region.dimensions > 4 )
+            {
+                continue;
+            }
+
+            size_t count = 1;
+            for( int i = 0; i < region.dimensions; i++ )
+            {
+                count *= (size_t)std::max( region.count[i], 0 );
+            }
+
+            size_t offset = output.size();
+            output.resize( offset + count );
+            float* out = output.data() + offset;
+
+            if( !count )
+            {
+                continue;
+            }
+
+            switch( region.dimensions )
+            {
+            case 2:
+                generator->GenUniformGrid2D( out, region.start[0], region.start[1], region.count[0], region.count[1],
+                                             region.step[0], region.step[1], region.seed );
+                break;
+            case 3:
+                generator->GenUniformGrid3D( out, region.start[0], region.start[1], region.start[2], region.count[0], region.count[1], region.count[2],
+                                             region.step[0], region.step[1], region.step[2], region.seed );
+                break;
+            case 4:
+                generator->GenUniformGrid4D( out, region.start[0], region.start[1], region.start[2], region.start[3], region.count[0], region.count[1], region.count[2], region.count[3],
+                                             region.step[0], region.step[1], region.step[2], region.step[3], region.seed );
+                break;
+            }
+        }
+        return true;
+    }
+
+    // Per sample values of a source or hybrid input, null if the source could not be generated
+    class InputValues
+    {
+    public:
+        InputValues( const NodeData* source, float constant, const OutputMap& outputs, size_t samples ) : mConstant( constant )
+        {
+            if( source )
+            {
+                auto find = outputs.find( source );
+                mValid = find != outputs.end() && find->second.size() == samples;
+                mValues = mValid ? find->second.data() : nullptr;
+            }
+        }
+
+        InputValues( const std::pair<NodeData*, float>& hybrid, const OutputMap& outputs, size_t samples ) :
+            InputValues( hybrid.first, hybrid.second, outputs, samples ) { }
+
+        explicit operator bool() const { return mValid; }
+
+        float operator []( size_t i ) const { return mValues ? mValues[i] : mConstant; }
+
+    private:
+        const float* mValues = nullptr;
+        float mConstant;
+        bool mValid = true;
+    };
+
+    static void CountBranches( const NodeData* nodeData, const OutputMap& outputs, NodeDataProfile& profile )
+    {
+        size_t samples = profile.samples;
+
+        if( Is<Fade>( nodeData ) )
+        {
+            InputValues fade( nodeData->hybrids[0], outputs, samples );
+            InputValues fadeMin( nodeData->hybrids[1], outputs, samples );
+            InputValues fadeMax( nodeData->hybrids[2], outputs, samples );
+
+            if( !fade || !fadeMin || !fadeMax )
+            {
+                return;
+            }
+
+            for( size_t i = 0; i < samples; i++ )
+            {
+                float fadeRange = fadeMax[i] - fadeMin[i];
+
+                // Zero range blends 50/50
+                if( fadeRange == 0 )
+                {
+                    continue;
+                }
+
+                float t = ( fade[i] - fadeMin[i] ) / fadeRange;
+
+                profile.branchLow += t <= 0;
+                profile.branchHigh += t >= 1;
+            }
+        }
+        else if( Is<Select>( nodeData ) )
+        {
+            InputValues condition( nodeData->nodeLookups[0], 0, outputs, samples );
+            InputValues threshold( nodeData->hybrids[0], outputs, samples );
+            InputValues falloff( nodeData->hybrids[1], outputs, samples );
+
+            if( !nodeData->nodeLookups[0] || !condition || !threshold || !falloff )
+            {
+                return;
+            }
+
+            for( size_t i = 0; i < samples; i++ )
+            {
+                float falloffClamped = std::max( falloff[i], 0.0f );
+                float t = ( condition[i] - threshold[i] + falloffClamped ) / std::max( falloffClamped + falloffClamped, std::numeric_limits<float>::min() );
+
+                profile.branchLow += t <= 0;
+                profile.branchHigh += t >= 1;
+            }
+        }
+        else if( Is<Remap>( nodeData ) )
+        {
+            InputValues source( nodeData->nodeLookups[0], 0, outputs, samples );
+            InputValues fromMin( nodeData->hybrids[0], outputs, samples );
+            InputValues fromMax( nodeData->hybrids[1], outputs, samples );
+            InputValues toMin( nodeData->hybrids[2], outputs, samples );
+            InputValues toMax( nodeData->hybrids[3], outputs, samples );
+
+            if( !nodeData->nodeLookups[0] || !source || !fromMin || !fromMax || !toMin || !toMax )
+            {
+                return;
+            }
+
+            for( size_t i = 0; i < samples; i++ )
+            {
+                float result = toMin[i] + ( ( source[i] - fromMin[i] ) / ( fromMax[i] - fromMin[i] ) * ( toMax[i] - toMin[i] ) );
+                bool nan = std::isnan( result );
+
+                profile.branchLow += nan || result < toMin[i];
+                profile.branchHigh += nan || result > toMax[i];
+            }
+        }
+        else if( Is<Min>( nodeData ) || Is<Max>( nodeData ) )
+        {
+            InputValues lhs( nodeData->nodeLookups[0], 0, outputs, samples );
+            InputValues rhs( nodeData->hybrids[0], outputs, samples );
+
+            if( !nodeData->nodeLookups[0] || !lhs || !rhs )
+            {
+                return;
+            }
+
+            bool isMin = Is<Min>( nodeData );
+
+            for( size_t i = 0; i < samples; i++ )
+            {
+                bool nan = std::isnan( lhs[i] ) || std::isnan( rhs[i] );
+
+                profile.branchLow += nan || ( isMin ? lhs[i] < rhs[i] : lhs[i] > rhs[i] );
+                profile.branchHigh += nan || ( isMin ? rhs[i] < lhs[i] : rhs[i] > lhs[i] );
+            }
+        }
+    }
+
+    class Specializer
+    {
+    public:
+        Specializer( const std::vector<NodeDataProfile>& profile, std::vector<std::unique_ptr<NodeData>>& nodeDataOut, std::vector<std::string>* changesOut, float constantTolerance ) :
+            mNodeDataOut( nodeDataOut ), mChangesOut( changesOut ), mConstantTolerance( constantTolerance )
+        {
+            for( const NodeDataProfile& nodeProfile : profile )
+            {
+                mProfiles.emplace( nodeProfile.nodeData, &nodeProfile );
+            }
+        }
+
+        // Replaced nodes are specialized before their sources, so sources of skipped branches are never visited
+        NodeData* Specialize( NodeData* nodeData )
+        {
+            if( !nodeData || !nodeData->metadata )
+            {
+                return nodeData;
+            }
+
+            auto find = mReplacements.find( nodeData );
+            if( find != mReplacements.end() )
+            {
+                return find->second;
+            }
+
+            // Leave loops untouched
+            if( !mInProgress.insert( nodeData ).second )
+            {
+                return nodeData;
+            }
+
+            NodeData* replacement = SpecializeNode( nodeData );
+
+            if( replacement != nodeData )
+            {
+                replacement = Specialize( replacement );
+            }
+            else
+            {
+                for( NodeData*& source : nodeData->nodeLookups )
+                {
+                    source = Specialize( source );
+                }
+
+                for( auto& hybrid : nodeData->hybrids )
+                {
+                    hybrid.first = Specialize( hybrid.first );
+                }
+            }
+
+            mInProgress.erase( nodeData );
+            mReplacements.emplace( nodeData, replacement );
+            return replacement;
+        }
+
+    private:
+        void Report( const NodeData* nodeData, const char* change )
+        {
+            if( mChangesOut )
+            {
+                mChangesOut->emplace_back( std::string( nodeData->metadata->name ) + ": " + change );
+            }
+        }
+
+        NodeData* NewConstant( float value )
+        {
+            NodeData* constant = mNodeDataOut.emplace_back( new NodeData( &Metadata::Get<Constant>() ) ).get();
+            constant->variables[0] = value;
+            return constant;
+        }
+
+        NodeData* SpecializeNode( NodeData* nodeData )
+        {
+            auto find = mProfiles.find( nodeData );
+
+            if( find == mProfiles.end() || !find->second->samples )
+            {
+                return nodeData;
+            }
+
+            const NodeDataProfile& profile = *find->second;
+
+            if( !Is<Constant>( nodeData ) && !profile.nanSamples && profile.max - profile.min <= mConstantTolerance )
+            {
+                Report( nodeData, "output was constant over profiled regions, replaced with Constant" );
+                return NewConstant( profile.min + ( profile.max - profile.min ) * 0.5f );
+            }
+
+            if( Is<Fade>( nodeData ) || Is<Select>( nodeData ) )
+            {
+                // Fade: A, B; Select: Condition, A, B
+                size_t aIdx = Is<Fade>( nodeData ) ? 0 : 1;
+
+                if( profile.branchLow == profile.samples && nodeData->nodeLookups[aIdx] )
+                {
+                    Report( nodeData, "always fully A, replaced with A" );
+                    return nodeData->nodeLookups[aIdx];
+                }
+                if( profile.branchHigh == profile.samples && nodeData->nodeLookups[aIdx + 1] )
+                {
+                    Report( nodeData, "always fully B, replaced with B" );
+                    return nodeData->nodeLookups[aIdx + 1];
+                }
+            }
+            else if( Is<Min>( nodeData ) || Is<Max>( nodeData ) )
+            {
+                if( !profile.branchHigh && nodeData->nodeLookups[0] )
+                {
+                    Report( nodeData, "LHS was always selected, replaced with LHS" );
+                    return nodeData->nodeLookups[0];
+                }
+                if( !profile.branchLow )
+                {
+                    const auto& rhs = nodeData->hybrids[0];
+
+                    Report( nodeData, "RHS was always selected, replaced with RHS" );
+                    return rhs.first ? rhs.first : NewConstant( rhs.second );
+                }
+            }
+            else if( Is<Remap>( nodeData ) )
+            {
+                if( nodeData->variables[0].i == (int)Boolean::True && !profile.branchLow && !profile.branchHigh )
+                {
+                    Report( nodeData, "output never clamped, disabled Clamp Output" );
+                    nodeData->variables[0] = (int)Boolean::False;
+                }
+            }
+
+            return nodeData;
+        }
+
+        std::vector<std::unique_ptr<NodeData>>& mNodeDataOut;
+        std::vector<std::string>* mChangesOut;
+        float mConstantTolerance;
+        std::unordered_map<const NodeData*, const NodeDataProfile*> mProfiles;
+        std::unordered_map<NodeData*, NodeData*> mReplacements;
+        std::unordered_set<NodeData*> mInProgress;
+    };
+} // namespace NodeDataSpecialize
+
+std::vector<NodeDataProfile> Metadata::ProfileNodeData( NodeData* nodeData, const std::vector<NodeDataProfileRegion>& regions, FastSIMD::FeatureSet maxFeatureSet )
+{
+    // Depth first order from the root, shared nodes are profiled once
+    std::vector<NodeData*> nodes;
+    std::unordered_set<const NodeData*> visited;
+    std::vector<NodeData*> stack = { nodeData };
+
+    while( !stack.empty() )
+    {
+        NodeData* node = stack.back();
+        stack.pop_back();
+
+        if( !node || !node->metadata || !visited.insert( node ).second )
+        {
+            continue;
+        }
+
+        nodes.push_back( node );
+
+        for( auto itr = node->hybrids.rbegin(); itr != node->hybrids.rend(); ++itr )
+        {
+            stack.push_back( itr->first );
+        }
+        for( auto itr = node->nodeLookups.rbegin(); itr != node->nodeLookups.rend(); ++itr )
+        {
+            stack.push_back( *itr );
+        }
+    }
+
+    // Nodes below an input transforming node are generated at positions or seeds the regions don't describe,
+    // they are left unprofiled so SpecializeNodeData() keeps them unchanged
+    std::unordered_set<const NodeData*> transformed;
+
+    for( NodeData* node : nodes )
+    {
+        if( NodeDataSpecialize::PassesInputsToSources( node ) )
+        {
+            continue;
+        }
+
+        stack.assign( node->nodeLookups.begin(), node->nodeLookups.end() );
+        for( size_t i = 0; i < node->hybrids.size(); i++ )
+        {
+            if( NodeDataSpecialize::TransformsHybridInputs( node, i ) )
+            {
+                stack.push_back( node->hybrids[i].first );
+            }
+        }
+
+        while( !stack.empty() )
+        {
+            NodeData* source = stack.back();
+            stack.pop_back();
+
+            if( !source || !source->metadata || !transformed.insert( source ).second )
+            {
+                continue;
+            }
+
+            stack.insert( stack.end(), source->nodeLookups.begin(), source->nodeLookups.end() );
+            for( const auto& hybrid : source->hybrids )
+            {
+                stack.push_back( hybrid.first );
+            }
+        }
+    }
+
+    NodeDataSpecialize::OutputMap outputs;
+
+    for( NodeData* node : nodes )
+    {
+        if( transformed.count( node ) )
+        {
+            continue;
+        }
+
+        std::vector<float> output;
+
+        if( NodeDataSpecialize::GenerateRegions( node, regions, maxFeatureSet, output ) )
+        {
+            outputs.emplace( node, std::move( output ) );
+        }
+    }
+
+    std::vector<NodeDataProfile> profiles;
+
+    for( NodeData* node : nodes )
+    {
+        auto find = outputs.find( node );
+
+        if( find == outputs.end() )
+        {
+            continue;
+        }
+
+        NodeDataProfile& profile = profiles.emplace_back();
+        profile.nodeData = node;
+        profile.samples = find->second.size();
+        profile.min = std::numeric_limits<float>::infinity();
+        profile.max = -std::numeric_limits<float>::infinity();
+
+        for( float value : find->second )
+        {
+            if( std::isnan( value ) )
+            {
+                profile.nanSamples++;
+                continue;
+            }
+            profile.min = std::min( profile.min, value );
+            profile.max = std::max( profile.max, value );
+        }
+
+        if( profile.nanSamples == profile.samples )
+        {
+            profile.min = profile.max = 0;
+        }
+
+        NodeDataSpecialize::CountBranches( node, outputs, profile );
+    }
+
+    return profiles;
+}
+
+NodeData* Metadata::SpecializeNodeData( NodeData* nodeData, const std::vector<NodeDataProfile>& profile, std::vector<std::unique_ptr<NodeData>>& nodeDataOut,
+                                        std::vector<std::string>* changesOut, float constantTolerance )
+{
+    NodeDataSpecialize::Specializer specializer( profile, nodeDataOut, changesOut, constantTolerance );
+
+    return SimplifyNodeData( specializer.Specialize( nodeData ), nodeDataOut, changesOut );
+}
+
+std::string Metadata::SpecializeEncodedNodeTree( const char* serialisedBase64NodeData, const std::vector<NodeDataProfileRegion>& regions,
+                                                 std::vector<std::string>* changesOut, float constantTolerance )
+{
+    std::vector<std::unique_ptr<NodeData>> nodeDataOut;
+    NodeData* nodeData = DeserialiseNodeData( serialisedBase64NodeData, nodeDataOut );
+
+    if( !nodeData )
+    {
+        return "";
+    }
+
+    std::vector<NodeDataProfile> profile = ProfileNodeData( nodeData, regions );
+
+    return SerialiseNodeData( SpecializeNodeData( nodeData, profile, nodeDataOut, changesOut, constantTolerance ) );
+}
+
+namespace NodeCost
+{
+    struct TableEntry
+    {
+        const char* nodeName;
+        const char* featureSet; // nullptr for estimates used when a feature set has no calibrated entry
+        float sampleCost[3];    // 2D, 3D, 4D
+    };
+
+    static constexpr TableEntry kTable[] =
+    {
+#include "NodeCostTable.inl"
+    };
+
+    // Used for node types missing from the table
+    static constexpr float kDefaultSampleCost = 0.1f;
+
+    // Table entries for each node id, built on first use since metadata names are assigned after construction
+    static const std::vector<std::vector<const TableEntry*>>& GetEntriesById()
+    {
+        static const std::vector<std::vector<const TableEntry*>> sEntriesById = []
+        {
+            std::vector<std::vector<const TableEntry*>> entriesById( Metadata::GetAll().size() );
+
+            for( const TableEntry& entry : kTable )
+            {
+                for( const Metadata* metadata : Metadata::GetAll() )
+                {
+                    if( std::strcmp( metadata->name, entry.nodeName ) == 0 )
+                    {
+                        entriesById[metadata->id].push_back( &entry );
+                        break;
+                    }
+                }
+            }
+            return entriesById;
+        }();
+
+        return sEntriesById;
+    }
+} // namespace NodeCost
+
+float Metadata::GetSampleCost( int dimensions, FastSIMD::FeatureSet featureSet ) const
+{
+    if( dimensions < 2 || dimensions > 4 )
+    {
+        return 0.0f;
+    }
+
+    const char* featureSetName = FastSIMD::GetFeatureSetString( featureSet );
+    const NodeCost::TableEntry* estimate = nullptr;
+
+    for( const NodeCost::TableEntry* entry : NodeCost::GetEntriesById()[id] )
+    {
+        if( !entry->featureSet )
+        {
+            estimate = entry;
+        }
+        else if( std::strcmp( entry->featureSet, featureSetName ) == 0 )
+        {
+            return entry->sampleCost[dimensions - 2];
+        }
+    }
+
+    return estimate ? estimate->sampleCost[dimensions - 2] : NodeCost::kDefaultSampleCost;
+}
+
+float Generator::EstimateCost( int dimensions ) const
+{
+    return GetMetadata().GetSampleCost( dimensions, GetActiveFeatureSet() );
+}
+
 std::string Metadata::FormatMetadataNodeName( const Metadata* metadata, bool removeGroups )
 {
     std::string string;
@@ -0,0 +1,58 @@
+// Per sample generation cost of each node type in nanoseconds, excluding the cost of source nodes
+// Format: { node name, feature set name or nullptr, { 2D, 3D, 4D } }
+// Rows with a nullptr feature set are used for feature sets without a calibrated row
+// Regenerate by running: FastNoiseBenchmark --count_sources > source_counts.txt in a FASTNOISE2_PROFILING build
+// Then: FastNoiseBenchmark --calibrate_cost=source_counts.txt > src/FastNoise/NodeCostTable.inl in a normal build
+// Not calibrated yet: every row below is a hand written estimate, not output of --calibrate_cost
+// Only the relative cost between node types is meaningful
+
+{ "Constant", nullptr, { 0.05f, 0.05f, 0.05f } },
+{ "White", nullptr, { 0.25f, 0.30f, 0.35f } },
+{ "Checkerboard", nullptr, { 0.20f, 0.25f, 0.30f } },
+{ "SineWave", nullptr, { 0.35f, 0.45f, 0.55f } },
+{ "Gradient", nullptr, { 0.10f, 0.12f, 0.15f } },
+{ "DistanceToPoint", nullptr, { 0.15f, 0.20f, 0.25f } },
+{ "Simplex", nullptr, { 0.60f, 1.10f, 1.90f } },
+{ "SuperSimplex", nullptr, { 1.00f, 2.20f, 4.00f } },
+{ "Perlin", nullptr, { 0.70f, 1.30f, 2.60f } },
+{ "Value", nullptr, { 0.55f, 1.05f, 2.10f } },
+{ "CellularValue", nullptr, { 2.70f, 9.50f, 34.00f } },
+{ "CellularDistance", nullptr, { 3.00f, 10.50f, 38.00f } },
+{ "CellularLookup", nullptr, { 2.90f, 10.00f, 36.00f } },
+{ "FractalFBm", nullptr, { 0.15f, 0.20f, 0.25f } },
+{ "PingPong", nullptr, { 0.10f, 0.10f, 0.10f } },
+{ "FractalRidged", nullptr, { 0.15f, 0.20f, 0.25f } },
+{ "DomainWarpSimplex", nullptr, { 1.60f, 3.20f, 5.80f } },
+{ "DomainWarpSuperSimplex", nullptr, { 2.40f, 5.60f, 10.50f } },
+{ "DomainWarpGradient", nullptr, { 1.50f, 3.50f, 7.50f } },
+{ "DomainWarpFractalProgressive", nullptr, { 0.20f, 0.25f, 0.30f } },
+{ "DomainWarpFractalIndependent", nullptr, { 0.20f, 0.25f, 0.30f } },
+{ "Add", nullptr, { 0.05f, 0.05f, 0.05f } },
+{ "Subtract", nullptr, { 0.05f, 0.05f, 0.05f } },
+{ "Multiply", nullptr, { 0.05f, 0.05f, 0.05f } },
+{ "Divide", nullptr, { 0.08f, 0.08f, 0.08f } },
+{ "Abs", nullptr, { 0.05f, 0.05f, 0.05f } },
+{ "Min", nullptr, { 0.05f, 0.05f, 0.05f } },
+{ "Max", nullptr, { 0.05f, 0.05f, 0.05f } },
+{ "MinSmooth", nullptr, { 0.20f, 0.20f, 0.20f } },
+{ "MaxSmooth", nullptr, { 0.20f, 0.20f, 0.20f } },
+{ "SignedSquareRoot", nullptr, { 0.08f, 0.08f, 0.08f } },
+{ "PowFloat", nullptr, { 0.35f, 0.35f, 0.35f } },
+{ "PowInt", nullptr, { 0.10f, 0.10f, 0.10f } },
+{ "DomainScale", nullptr, { 0.05f, 0.06f, 0.07f } },
+{ "DomainOffset", nullptr, { 0.05f, 0.06f, 0.07f } },
+{ "DomainRotate", nullptr, { 0.10f, 0.15f, 0.20f } },
+{ "DomainAxisScale", nullptr, { 0.05f, 0.06f, 0.07f } },
+{ "SeedOffset", nullptr, { 0.03f, 0.03f, 0.03f } },
+{ "ConvertRGBA8", nullptr, { 0.10f, 0.10f, 0.10f } },
+{ "GeneratorCache", nullptr, { 0.10f, 0.12f, 0.14f } },
+{ "Fade", nullptr, { 0.10f, 0.10f, 0.10f } },
+{ "Remap", nullptr, { 0.10f, 0.10f, 0.10f } },
+{ "Terrace", nullptr, { 0.15f, 0.15f, 0.15f } },
+{ "AddDimension", nullptr, { 0.03f, 0.03f, 0.03f } },
+{ "RemoveDimension", nullptr, { 0.03f, 0.03f, 0.03f } },
+{ "Modulus", nullptr, { 0.10f, 0.10f, 0.10f } },
+{ "DomainRotatePlane", nullptr, { 0.08f, 0.10f, 0.12f } },
+// Select and Switch: estimated from the Fade row, Switch also evaluates a source per selected index
+{ "Select", nullptr, { 0.10f, 0.10f, 0.10f } },
+{ "Switch", nullptr, { 0.12f, 0.12f, 0.12f } },
@@ -0,0 +1,382 @@
+#include <FastNoise/Utility/NodeProfiler.h>
+#include <FastNoise/FastNoise.h>
+#include <FastNoise/Metadata.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#if defined( _M_X64 ) || defined( _M_IX86 )
+#include <intrin.h>
+#define FASTNOISE_PROFILER_RDTSC
+#elif defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#define FASTNOISE_PROFILER_RDTSC
+#endif
+
+namespace FastNoise
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // Read on entry and exit of every profiled node, the TSC is much cheaper than a clock call
+        // Ticks are converted to nanoseconds using the session duration
+        inline uint64_t ReadProfileTicks()
+        {
+#ifdef FASTNOISE_PROFILER_RDTSC
+            return __rdtsc();
+#else
+            return (uint64_t)Clock::now().time_since_epoch().count();
+#endif
+        }
+
+        // One node on a call path, records form a tree through parent/firstChild/nextSibling
+        struct CallRecord
+        {
+            const Generator* node;
+            const Metadata* metadata;
+            int32_t parent;
+            int32_t firstChild = -1;
+            int32_t nextSibling = -1;
+            uint64_t calls = 0;
+            uint64_t samples = 0;
+            uint64_t ticks = 0;
+        };
+
+        struct CallStackEntry
+        {
+            int32_t record;
+            uint64_t startTicks;
+        };
+
+        // Only written by the owning thread, the mutex is held for the duration of each
+        // root generation call so results are never read from a partially recorded call
+        struct ThreadProfile
+        {
+            std::mutex mutex;
+            uint32_t session = 0;
+            std::vector<CallRecord> records; // Record 0 is the thread root
+            std::vector<CallStackEntry> callStack;
+        };
+
+        struct ProfileSession
+        {
+            std::mutex mutex;
+            std::vector<std::shared_ptr<ThreadProfile>> threadProfiles;
+            uint32_t lastSession = 0;
+            bool ended = false;
+            uint64_t startTicks = 0, endTicks = 0;
+            Clock::time_point startTime, endTime;
+        };
+
+        // Active session id, 0 while not profiling
+        std::atomic<uint32_t> gActiveSession = 0;
+
+        ProfileSession& GetProfileSession()
+        {
+            static ProfileSession session;
+            return session;
+        }
+
+        // Shared with the session so results outlive threads that exit before they are read
+        thread_local std::shared_ptr<ThreadProfile> tThreadProfile;
+
+        ThreadProfile* StartThreadProfile( uint32_t sessionId )
+        {
+            ProfileSession& session = GetProfileSession();
+            std::lock_guard lock( session.mutex );
+
+            if( gActiveSession.load( std::memory_order_relaxed ) != sessionId )
+            {
+                return nullptr;
+            }
+
+            if( !tThreadProfile )
+            {
+                tThreadProfile = std::make_shared<ThreadProfile>();
+            }
+
+            ThreadProfile* profile = tThreadProfile.get();
+            std::lock_guard profileLock( profile->mutex );
+
+            profile->session = sessionId;
+            profile->records.assign( 1, CallRecord{ nullptr, nullptr, -1 } );
+            session.threadProfiles.push_back( tThreadProfile );
+            return profile;
+        }
+
+        struct MergedRecord
+        {
+            const Generator* node;
+            const Metadata* metadata;
+            int32_t parent;
+            uint64_t calls = 0;
+            uint64_t samples = 0;
+            uint64_t ticks = 0;
+            std::vector<int32_t> children;
+        };
+    }
+
+    bool NodeProfiler::IsAvailable()
+    {
+        return FASTNOISE_PROFILING;
+    }
+
+    bool NodeProfiler::Begin()
+    {
+        if( !IsAvailable() )
+        {
+            return false;
+        }
+
+        ProfileSession& session = GetProfileSession();
+        std::lock_guard lock( session.mutex );
+
+        if( ++session.lastSession == 0 )
+        {
+            session.lastSession = 1;
+        }
+
+        session.threadProfiles.clear();
+        session.ended = false;
+        session.startTime = Clock::now();
+        session.startTicks = ReadProfileTicks();
+
+        gActiveSession.store( session.lastSession, std::memory_order_relaxed );
+        return true;
+    }
+
+    void NodeProfiler::End()
+    {
+        ProfileSession& session = GetProfileSession();
+        std::lock_guard lock( session.mutex );
+
+        if( gActiveSession.exchange( 0, std::memory_order_relaxed ) )
+        {
+            session.ended = true;
+            session.endTicks = ReadProfileTicks();
+            session.endTime = Clock::now();
+        }
+    }
+
+    bool NodeProfiler::EnterNode( const Generator* node, size_t samples )
+    {
+        uint32_t sessionId = gActiveSession.load( std::memory_order_relaxed );
+
+        if( !sessionId )
+        {
+            return false;
+        }
+
+        ThreadProfile* profile = tThreadProfile.get();
+
+        if( !profile || profile->session != sessionId )
+        {
+            // A call that started in the previous session finishes in that session, nodes it calls are not recorded
+            if( profile && !profile->callStack.empty() )
+            {
+                return false;
+            }
+
+            if( !( profile = StartThreadProfile( sessionId ) ) )
+            {
+                return false;
+            }
+        }
+
+        int32_t parent = 0;
+
+        if( profile->callStack.empty() )
+        {
+            profile->mutex.lock();
+        }
+        else
+        {
+            parent = profile->callStack.back().record;
+        }
+
+        int32_t* link = &profile->records[parent].firstChild;
+
+        while( *link >= 0 && profile->records[*link].node != node )
+        {
+            link = &profile->records[*link].nextSibling;
+        }
+
+        int32_t recordIdx = *link;
+
+        if( recordIdx < 0 )
+        {
+            recordIdx = *link = (int32_t)profile->records.size();
+            profile->records.push_back( CallRecord{ node, &node->GetMetadata(), parent } );
+        }
+
+        CallRecord& record = profile->records[recordIdx];
+        record.calls++;
+        record.samples += samples;
+
+        profile->callStack.push_back( { recordIdx, ReadProfileTicks() } );
+        return true;
+    }
+
+    void NodeProfiler::ExitNode()
+    {
+        uint64_t endTicks = ReadProfileTicks();
+        ThreadProfile* profile = tThreadProfile.get();
+
+        assert( profile && !profile->callStack.empty() );
+        CallStackEntry entry = profile->callStack.back();
+        profile->callStack.pop_back();
+
+        profile->records[entry.record].ticks += endTicks - entry.startTicks;
+
+        if( profile->callStack.empty() )
+        {
+            profile->mutex.unlock();
+        }
+    }
+
+    std::vector<NodeProfile> NodeProfiler::GetResults( const Generator* root )
+    {
+        ProfileSession& session = GetProfileSession();
+        std::lock_guard lock( session.mutex );
+
+        uint64_t endTicks = session.ended ? session.endTicks : ReadProfileTicks();
+        Clock::time_point endTime = session.ended ? session.endTime : Clock::now();
+
+        double sessionNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>( endTime - session.startTime ).count();
+        double nsPerTick = endTicks > session.startTicks ? sessionNs / (double)( endTicks - session.startTicks ) : 0.0;
+
+        // Merge identical call paths from all threads
+        std::vector<MergedRecord> merged;
+        std::vector<int32_t> roots;
+        std::map<std::pair<int32_t, const Generator*>, int32_t> mergedLookup;
+
+        for( const auto& profile : session.threadProfiles )
+        {
+            std::lock_guard profileLock( profile->mutex );
+
+            // Parents are always recorded before their children
+            std::vector<int32_t> mergedIdx( profile->records.size(), -1 );
+
+            for( size_t i = 1; i < profile->records.size(); i++ )
+            {
+                const CallRecord& record = profile->records[i];
+                int32_t parent = -1;
+
+                if( record.parent > 0 )
+                {
+                    if( ( parent = mergedIdx[record.parent] ) < 0 )
+                    {
+                        continue;
+                    }
+                }
+                else if( root && record.node != root )
+                {
+                    continue;
+                }
+
+                auto find = mergedLookup.try_emplace( { parent, record.node }, (int32_t)merged.size() );
+
+                if( find.second )
+                {
+                    merged.push_back( MergedRecord{ record.node, record.metadata, parent, 0, 0, 0, {} } );
+                    ( parent < 0 ? roots : merged[parent].children ).push_back( find.first->second );
+                }
+
+                MergedRecord& mergedRecord = merged[find.first->second];
+                mergedRecord.calls += record.calls;
+                mergedRecord.samples += record.samples;
+                mergedRecord.ticks += record.ticks;
+                mergedIdx[i] = find.first->second;
+            }
+        }
+
+        auto sortByTicks = [&merged]( std::vector<int32_t>& indices )
+        {
+            std::stable_sort( indices.begin(), indices.end(), [&merged]( int32_t a, int32_t b ) { return merged[a].ticks > merged[b].ticks; } );
+        };
+
+        std::vector<NodeProfile> results;
+        results.reserve( merged.size() );
+
+        std::vector<std::pair<int32_t, int>> stack; // { merged index, parent result index }
+        sortByTicks( roots );
+
+        for( auto itr = roots.rbegin(); itr != roots.rend(); ++itr )
+        {
+            stack.emplace_back( *itr, -1 );
+        }
+
+        while( !stack.empty() )
+        {
+            auto [mergedIdx, parent] = stack.back();
+            stack.pop_back();
+
+            MergedRecord& record = merged[mergedIdx];
+            sortByTicks( record.children );
+
+            uint64_t childTicks = 0;
+            for( int32_t child : record.children )
+            {
+                childTicks += merged[child].ticks;
+            }
+
+            NodeProfile& profile = results.emplace_back();
+            profile.node = record.node;
+            profile.metadata = record.metadata;
+            profile.name = Metadata::FormatMetadataNodeName( record.metadata );
+            profile.parent = parent;
+            profile.depth = parent < 0 ? 0 : results[parent].depth + 1;
+            profile.calls = record.calls;
+            profile.samples = record.samples;
+            profile.inclusiveNs = (double)record.ticks * nsPerTick;
+            profile.exclusiveNs = (double)( record.ticks - std::min( childTicks, record.ticks ) ) * nsPerTick;
+
+            int resultIdx = (int)results.size() - 1;
+            for( auto itr = record.children.rbegin(); itr != record.children.rend(); ++itr )
+            {
+                stack.emplace_back( *itr, resultIdx );
+            }
+        }
+
+        return results;
+    }
+
+    std::string NodeProfiler::FormatResults( const std::vector<NodeProfile>& results )
+    {
+        double totalNs = 0;
+        for( const NodeProfile& profile : results )
+        {
+            if( profile.parent < 0 )
+            {
+                totalNs += profile.inclusiveNs;
+            }
+        }
+
+        std::string string;
+        char line[256];
+
+        std::snprintf( line, sizeof( line ), "%-40s %12s %14s %12s %12s %8s\n", "Node", "Calls", "Samples", "Incl ms", "Excl ms", "Excl %" );
+        string += line;
+
+        for( const NodeProfile& profile : results )
+        {
+            std::string name( profile.depth * 2, ' ' );
+            name += profile.name;
+
+            std::snprintf( line, sizeof( line ), "%-40s %12llu %14llu %12.3f %12.3f %7.1f%%\n", name.c_str(),
+                (unsigned long long)profile.calls, (unsigned long long)profile.samples,
+                profile.inclusiveNs / 1e6, profile.exclusiveNs / 1e6,
+                totalNs > 0 ? profile.exclusiveNs / totalNs * 100.0 : 0.0 );
+            string += line;
+        }
+
+        return string;
+    }
+} // namespace FastNoise
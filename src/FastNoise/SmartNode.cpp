@@ -6,30 +6,89 @@
 #include <vector>
 #include <list>
 #include <cstring>
+#include <cstdint>
 #include <memory>
+#include <new>
 #include <algorithm>
 
 namespace FastNoise
 {
+    // Every pool block starts on this boundary, nodes with stricter alignment are not supported
+    static constexpr size_t kSmartNodeBlockAlignment = 64;
+
+    // A pool only hands out blocks of a single size class, freed blocks go on an intrusive free list
+    // so a pool is reused after partial frees instead of only once it is completely empty
+    // Arena pools (block size 0) bump allocate mixed sizes and are released as a unit once sealed and empty
+    // Every pool starts on a slab boundary, so the pool owning a block is found by masking the block address
+    // Only size class pools are listed, oversized block pools and arena pools are released directly once empty
     class SmartNodeManagerPool
     {
     public:
-        SmartNodeManagerPool( uint32_t size ) :
-            mAllocState( 0 ), mNextPool( nullptr ), mPoolSize( std::min<uint32_t>( size, INT32_MAX ) )
+        static constexpr uint32_t kRemovedFlag = 1u << 31;
+        static constexpr uint32_t kSealedFlag = 1u << 30;
+        static constexpr uint32_t kFlagMask = kRemovedFlag | kSealedFlag;
+        static constexpr uint32_t kUnlisted = ~0u;
+
+        SmartNodeManagerPool( size_t allocSize, uint32_t blockSize, uint32_t sizeClass ) :
+            mAllocState( 0 ), mFreeList( 0 ), mNextPool( nullptr ), mAllocSize( allocSize ), mArenaReserve( 0 ), mBlockSize( blockSize ), mSizeClass( sizeClass ),
+            mPoolSize( (uint32_t)std::min<size_t>( blockSize ? ( allocSize - HeaderSize() ) / blockSize * blockSize : allocSize - HeaderSize(), INT32_MAX ) )
         { }
 
         SmartNodeManagerPool( const SmartNodeManagerPool& ) = delete;
         SmartNodeManagerPool( SmartNodeManagerPool&& ) = delete;
+
+        static constexpr size_t HeaderSize()
+        {
+            return ( sizeof( SmartNodeManagerPool ) + kSmartNodeBlockAlignment - 1 ) & ~( kSmartNodeBlockAlignment - 1 );
+        }
         
         bool Contains( const void* ptr ) const
         {
             uint8_t* pool = GetPool();
-            uint32_t nextFreeIndex = (uint32_t)( mAllocState.load( std::memory_order_relaxed ) >> 32 );
 
-            return ptr >= pool && ptr < pool + ( nextFreeIndex - 1 );
+            return ptr >= pool && ptr < pool + mPoolSize;
+        }
+
+        void* TryAlloc()
+        {
+            // Reserve an alloc first so the pool can't be removed while a block is being taken
+            uint64_t allocState = mAllocState.load( std::memory_order_relaxed );
+
+            do
+            {
+                if( (uint32_t)allocState & kRemovedFlag )
+                {
+                    return nullptr;
+                }
+            } while( !mAllocState.compare_exchange_weak( allocState, allocState + 1, std::memory_order_acquire, std::memory_order_relaxed ) );
+
+            if( void* ptr = PopFreeBlock() )
+            {
+                return ptr;
+            }
+
+            // Free list empty, bump allocate from untouched space
+            allocState = mAllocState.load( std::memory_order_relaxed );
+            uint64_t newAllocState;
+
+            do
+            {
+                uint32_t nextFreeIndex = (uint32_t)( allocState >> 32 );
+
+                if( mPoolSize - nextFreeIndex < mBlockSize )
+                {
+                    mAllocState.fetch_sub( 1, std::memory_order_relaxed );
+                    return nullptr;
+                }
+
+                newAllocState = allocState + ( (uint64_t)mBlockSize << 32 );
+
+            } while( !mAllocState.compare_exchange_weak( allocState, newAllocState, std::memory_order_relaxed ) );
+
+            return GetPool() + (uint32_t)( allocState >> 32 );
         }
 
-        void* TryAlloc( size_t size, size_t align )
+        void* TryAllocArena( size_t size, size_t align, uint32_t& usedBytes )
         {
             uint8_t* pool = GetPool();
             uint64_t allocState = mAllocState.load( std::memory_order_relaxed );
@@ -38,68 +97,159 @@ namespace FastNoise
 
             do
             {
-                uint32_t activeAllocs = (uint32_t)allocState;
-                uint32_t nextFreeIndex = (uint32_t)(allocState >> 32);
+                if( (uint32_t)allocState & kFlagMask )
+                {
+                    return nullptr;
+                }
 
-                // Reset pool counter if there are no allocs
-                startSlot    = activeAllocs ? pool      + nextFreeIndex : pool;
-                size_t space = activeAllocs ? mPoolSize - nextFreeIndex : mPoolSize;
+                uint32_t nextFreeIndex = (uint32_t)( allocState >> 32 );
+
+                startSlot = pool + nextFreeIndex;
+                size_t space = mPoolSize - nextFreeIndex;
 
                 if( !std::align( align, size, startSlot, space ) )
                 {
                     return nullptr;
                 }
 
-                nextFreeIndex = static_cast<uint32_t>( ( (uint8_t*)startSlot + size ) - pool );
-                activeAllocs++;
+                uint32_t newFreeIndex = static_cast<uint32_t>( ( (uint8_t*)startSlot + size ) - pool );
+                usedBytes = newFreeIndex - nextFreeIndex;
+
+                newAllocState = ( allocState + 1 + ( (uint64_t)usedBytes << 32 ) );
 
-                newAllocState = (uint64_t)activeAllocs | ( (uint64_t)nextFreeIndex << 32 );
-                                
             } while( !mAllocState.compare_exchange_weak( allocState, newAllocState, std::memory_order_relaxed ) );
 
             return startSlot;
         }
 
-        int32_t Free( const void* ptr )
+        // Returns remaining alloc count
+        int32_t Free( const void* ptr, bool& sealed )
         {
-            if( Contains( ptr ) )
-            {
-                uint64_t allocState = mAllocState.fetch_sub( 1, std::memory_order_relaxed );
+            assert( Contains( ptr ) );
 
-                assert( (uint32_t)allocState != 0 );
-                return (int32_t)allocState - 1;
+            if( mBlockSize )
+            {
+                PushFreeBlock( (uint32_t)( (const uint8_t*)ptr - GetPool() ) );
             }
 
-            return -1;
+            uint64_t allocState = mAllocState.fetch_sub( 1, std::memory_order_release );
+
+            assert( ( (uint32_t)allocState & ~kFlagMask ) != 0 );
+            sealed = (uint32_t)allocState & kSealedFlag;
+            return (int32_t)( (uint32_t)allocState & ~kFlagMask ) - 1;
+        }
+
+        // Stops further arena allocations, returns remaining alloc count
+        int32_t Seal()
+        {
+            uint64_t allocState = mAllocState.fetch_or( kSealedFlag, std::memory_order_acq_rel );
+
+            return (int32_t)( (uint32_t)allocState & ~kFlagMask );
         }
 
         int32_t AllocCount() const
         {
-            return (int32_t)mAllocState.load( std::memory_order_relaxed );
+            return (int32_t)( (uint32_t)mAllocState.load( std::memory_order_relaxed ) & ~kFlagMask );
+        }
+
+        uint32_t UsedBytes() const
+        {
+            return (uint32_t)( mAllocState.load( std::memory_order_relaxed ) >> 32 );
         }
 
         bool MarkForRemoval()
         {
             uint64_t allocState = mAllocState.load( std::memory_order_relaxed );
 
-            if( (uint32_t)allocState != 0 )
+            if( ( (uint32_t)allocState & ~kSealedFlag ) != 0 )
             {
                 return false;
             }
 
-            uint64_t newAllocState = ( (uint64_t)mPoolSize << 32 ) + 1; // Set as full
-
-            return mAllocState.compare_exchange_strong( allocState, newAllocState, std::memory_order_relaxed );
+            return mAllocState.compare_exchange_strong( allocState, allocState | kRemovedFlag, std::memory_order_acquire );
         }
 
         uint8_t* GetPool() const
         {
-            return (uint8_t*)this + sizeof( SmartNodeManagerPool );
+            return (uint8_t*)this + HeaderSize();
         }
 
-        std::atomic<uint64_t> mAllocState;
-        std::atomic<SmartNodeManagerPool*> mNextPool;
+        std::atomic<uint64_t> mAllocState; // Active allocs (low 31 bits) | removed flag | bump index (high 32 bits)
+        std::atomic<uint64_t> mFreeList;   // ABA tag (high 32 bits) | head block offset + 1, 0 if empty
+        std::atomic<SmartNodeManagerPool*> mNextPool; // Next pool in the size class list
+        size_t mAllocSize;
+        size_t mArenaReserve; // Arena bytes still to be placed in following slabs
+        uint32_t mBlockSize;
+        uint32_t mSizeClass;  // Index into the size class table, kUnlisted if not on a list
         uint32_t mPoolSize;
+
+    private:
+        std::atomic<uint32_t>* GetFreeLink( uint32_t offset ) const
+        {
+            return reinterpret_cast<std::atomic<uint32_t>*>( GetPool() + offset );
+        }
+
+        void* PopFreeBlock()
+        {
+            uint64_t head = mFreeList.load( std::memory_order_acquire );
+
+            while( (uint32_t)head )
+            {
+                uint32_t offset = (uint32_t)head - 1;
+                uint32_t next = GetFreeLink( offset )->load( std::memory_order_relaxed );
+                uint64_t newHead = ( ( ( head >> 32 ) + 1 ) << 32 ) | next;
+
+                if( mFreeList.compare_exchange_weak( head, newHead, std::memory_order_acquire, std::memory_order_acquire ) )
+                {
+                    return GetPool() + offset;
+                }
+            }
+
+            return nullptr;
+        }
+
+        void PushFreeBlock( uint32_t offset )
+        {
+            std::atomic<uint32_t>* link = GetFreeLink( offset );
+            uint64_t head = mFreeList.load( std::memory_order_relaxed );
+            uint64_t newHead;
+
+            do
+            {
+                link->store( (uint32_t)head, std::memory_order_relaxed );
+                newHead = ( ( ( head >> 32 ) + 1 ) << 32 ) | ( offset + 1 );
+
+            } while( !mFreeList.compare_exchange_weak( head, newHead, std::memory_order_release, std::memory_order_relaxed ) );
+        }
+    };
+
+    class SmartNodeMemoryAllocator;
+
+    // Small per thread stash of freed blocks, avoids touching shared pool state for tree churn on one thread
+    // Cached blocks still count as allocated in their pool until they are evicted or the thread exits
+    // Trivially destructible so it stays accessible during thread and static teardown, SmartNodeThreadCacheFlush empties it
+    struct SmartNodeThreadCache
+    {
+        static constexpr uint32_t kSizeClassCount = 16; // Blocks up to 1KiB
+        static constexpr uint32_t kMaxBlocks = 8;
+
+        struct Bin
+        {
+            uint32_t count;
+            void* blocks[kMaxBlocks];
+        };
+
+        SmartNodeMemoryAllocator* owner;
+        bool flushed; // Set at thread exit, nodes released after that bypass the cache
+        Bin bins[kSizeClassCount];
+    };
+
+    static thread_local SmartNodeThreadCache tThreadCache = {};
+
+    // Returns the thread's cached blocks to their pools at thread exit
+    struct SmartNodeThreadCacheFlush
+    {
+        ~SmartNodeThreadCacheFlush();
     };
     
     class SmartNodeMemoryAllocator
@@ -107,138 +257,537 @@ namespace FastNoise
     public:
         static inline uint32_t sNewPoolSize = 64 * 1024;
 
-        void* Alloc( size_t size, size_t align ) 
+        void* Alloc( size_t size, size_t align )
+        {
+            assert( align <= kSmartNodeBlockAlignment ); // Node alignment larger than pool block alignment
+            (void)align;
+
+            uint32_t blockSize = GetBlockSize( size );
+            void* ptr = TakeFromThreadCache( blockSize );
+
+            if( !ptr )
+            {
+                ptr = AllocBlock( blockSize );
+            }
+
+            if( ptr )
+            {
+                mLiveBytes.fetch_add( blockSize, std::memory_order_relaxed );
+                mLiveAllocs.fetch_add( 1, std::memory_order_relaxed );
+            }
+            return ptr;
+        }
+
+        void Free( const void* ptr )
         {
-            if( void* ptr = AllocFromPools( size, align ) )
+            SmartNodeManagerPool* pool = GetOwningPool( ptr );
+
+            mLiveAllocs.fetch_sub( 1, std::memory_order_relaxed );
+
+            // Arena bytes stay live until the whole arena is released
+            if( !pool->mBlockSize )
             {
-                return ptr;
+                bool sealed;
+
+                if( pool->Free( ptr, sealed ) == 0 && sealed )
+                {
+                    ReleaseUnlistedPool( pool );
+                }
+                return;
             }
 
-            std::lock_guard lock( mMutex );
+            mLiveBytes.fetch_sub( pool->mBlockSize, std::memory_order_relaxed );
 
-            if( void* ptr = AllocFromPools( size, align ) )
+            if( !PutInThreadCache( pool, ptr ) )
             {
-                return ptr;
+                FreeBlock( pool, ptr );
+            }
+        }
+
+        // Arenas larger than a slab continue in further slabs as they fill, see NextArenaSlab()
+        SmartNodeManagerPool* NewArena( size_t capacity )
+        {
+            size_t slabCapacity = std::min( capacity, GetSlabSize() - SmartNodeManagerPool::HeaderSize() );
+
+            SmartNodeManagerPool* arena = NewPool( SmartNodeManagerPool::HeaderSize() + slabCapacity, 0, SmartNodeManagerPool::kUnlisted );
+
+            if( arena )
+            {
+                arena->mArenaReserve = capacity - slabCapacity;
             }
-      
-            if( void* poolAlloc = std::malloc( std::max( (uint32_t)sizeof( SmartNodeManagerPool ), sNewPoolSize ) ) )
-            {        
-                SmartNodeManagerPool* newPool = new( poolAlloc ) SmartNodeManagerPool( sNewPoolSize - (uint32_t)sizeof( SmartNodeManagerPool ) );
+            return arena;
+        }
 
-                void* alloc = newPool->TryAlloc( size, align );
-                assert( alloc ); // Alloc too large to fit in empty pool, increase pool size
+        void* AllocArena( SmartNodeManagerPool* arena, size_t size, size_t align )
+        {
+            uint32_t usedBytes;
+            void* ptr = arena->TryAllocArena( size, align, usedBytes );
 
-                if( mPools )
-                {
-                    SmartNodeManagerPool* pool = mPools;
+            if( ptr )
+            {
+                mLiveBytes.fetch_add( usedBytes, std::memory_order_relaxed );
+                mLiveAllocs.fetch_add( 1, std::memory_order_relaxed );
+            }
+            return ptr;
+        }
 
-                    while( SmartNodeManagerPool* nextPool = pool->mNextPool.load( std::memory_order_relaxed ) )
-                    {
-                        pool = nextPool;
-                    }  
+        // Seals a full arena slab and starts the next one, nullptr if the arena capacity left can't hold size
+        SmartNodeManagerPool* NextArenaSlab( SmartNodeManagerPool* arena, size_t size, size_t align )
+        {
+            assert( align <= kSmartNodeBlockAlignment ); // Slabs start block aligned
+            (void)align;
 
-                    pool->mNextPool.store( newPool, std::memory_order_release );
-                }
-                else
+            // Space left unused at the end of the full slab is carried over
+            size_t capacity = arena->mArenaReserve + ( arena->mPoolSize - arena->UsedBytes() );
+
+            if( capacity < size )
+            {
+                return nullptr;
+            }
+
+            SmartNodeManagerPool* nextArena = NewArena( capacity );
+
+            if( nextArena )
+            {
+                SealArena( arena );
+            }
+            return nextArena;
+        }
+
+        void SealArena( SmartNodeManagerPool* arena )
+        {
+            if( arena->Seal() == 0 )
+            {
+                ReleaseUnlistedPool( arena );
+            }
+        }
+
+        void FlushThreadCache( SmartNodeThreadCache& cache )
+        {
+            for( SmartNodeThreadCache::Bin& bin : cache.bins )
+            {
+                while( bin.count )
                 {
-                    mPools = newPool;
+                    bin.count--;
+                    SmartNodeManagerPool* pool = GetOwningPool( bin.blocks[bin.count] );
+
+                    mCachedBytes.fetch_sub( pool->mBlockSize, std::memory_order_relaxed );
+                    FreeBlock( pool, bin.blocks[bin.count] );
                 }
+            }
+        }
 
-                return alloc;
-            } 
+        SmartNodeMemoryStats GetStats() const
+        {
+            SmartNodeMemoryStats stats;
 
-            return nullptr;
+            stats.liveBytes = mLiveBytes.load( std::memory_order_relaxed );
+            stats.liveAllocations = mLiveAllocs.load( std::memory_order_relaxed );
+            stats.threadCachedBytes = mCachedBytes.load( std::memory_order_relaxed );
+            stats.poolBytes = mPoolBytes.load( std::memory_order_relaxed );
+            stats.poolCount = mPoolCount.load( std::memory_order_relaxed );
+            stats.fragmentation = stats.poolBytes ? 1.0f - (float)( (double)stats.liveBytes / (double)stats.poolBytes ) : 0.0f;
+
+            return stats;
         }
 
-        void Free( const void* ptr )
+    private:
+        static constexpr uint32_t kSizeClassCount = 64; // Blocks up to 4KiB, larger blocks get a pool each
+        static constexpr size_t kMinSlabSize = 4 * 1024;
+
+        // Listed pools of one block size, pools removed from the list are freed once no walkers remain
+        struct alignas( kSmartNodeBlockAlignment ) SizeClass
+        {
+            std::atomic<SmartNodeManagerPool*> pools = nullptr;
+            std::atomic<SmartNodeManagerPool*> current = nullptr; // Pool of the latest alloc that walked the list
+            std::atomic<uint32_t> walkers = 0;
+            std::vector<SmartNodeManagerPool*> retired; // Requires mMutex
+        };
+
+        // Tracks threads walking a size class, retired pools are only freed once no walkers remain
+        class PoolWalkGuard
+        {
+        public:
+            PoolWalkGuard( std::atomic<uint32_t>& walkers ) : mWalkers( walkers )
+            {
+                mWalkers.fetch_add( 1, std::memory_order_seq_cst );
+            }
+
+            ~PoolWalkGuard()
+            {
+                mWalkers.fetch_sub( 1, std::memory_order_release );
+            }
+
+        private:
+            std::atomic<uint32_t>& mWalkers;
+        };
+
+        static uint32_t GetBlockSize( size_t size )
         {
-            SmartNodeManagerPool* pool = mPools;
+            return (uint32_t)( ( std::max<size_t>( size, 1 ) + kSmartNodeBlockAlignment - 1 ) & ~( kSmartNodeBlockAlignment - 1 ) );
+        }
+
+        // Fixed by the first pool, every pool is aligned to it so changing it later would break GetOwningPool()
+        size_t GetSlabSize()
+        {
+            size_t slabSize = mSlabSize.load( std::memory_order_relaxed );
 
-            while( pool )
+            if( !slabSize )
             {
-                int32_t allocCount = pool->Free( ptr );
+                size_t newSlabSize = kMinSlabSize;
 
-                if( allocCount >= 0 )
+                while( newSlabSize < sNewPoolSize && newSlabSize < ( (size_t)1 << 30 ) )
                 {
-                    if( allocCount == 0 )
-                    {
-                        RemoveEmptyPool();
-                    }
-                    return;
+                    newSlabSize *= 2;
                 }
 
-                pool = pool->mNextPool;
+                slabSize = mSlabSize.compare_exchange_strong( slabSize, newSlabSize, std::memory_order_relaxed ) ? newSlabSize : slabSize;
             }
+            return slabSize;
+        }
+
+        SmartNodeManagerPool* GetOwningPool( const void* ptr ) const
+        {
+            size_t slabSize = mSlabSize.load( std::memory_order_relaxed );
 
-            assert( 0 ); // Pointer not in any of the pools
+            assert( slabSize ); // Pointer not allocated from the pools
+            return reinterpret_cast<SmartNodeManagerPool*>( reinterpret_cast<uintptr_t>( ptr ) & ~(uintptr_t)( slabSize - 1 ) );
         }
-        
-    private:
-        void* AllocFromPools( size_t size, size_t align )
+
+        // Size class pools hold at least 2 blocks, larger blocks are unlisted
+        uint32_t GetSizeClass( uint32_t blockSize )
+        {
+            uint32_t sizeClass = blockSize / kSmartNodeBlockAlignment - 1;
+
+            if( sizeClass >= kSizeClassCount || (size_t)blockSize * 2 > GetSlabSize() - SmartNodeManagerPool::HeaderSize() )
+            {
+                return SmartNodeManagerPool::kUnlisted;
+            }
+            return sizeClass;
+        }
+
+        static SmartNodeThreadCache::Bin* GetThreadCacheBin( SmartNodeMemoryAllocator* allocator, uint32_t blockSize )
+        {
+            size_t sizeClass = blockSize / kSmartNodeBlockAlignment - 1;
+
+            if( !blockSize || sizeClass >= SmartNodeThreadCache::kSizeClassCount )
+            {
+                return nullptr;
+            }
+
+            if( tThreadCache.flushed )
+            {
+                return nullptr;
+            }
+
+            if( !tThreadCache.owner )
+            {
+                // Constructed on first use so its destructor runs at exit of every thread using the cache
+                static thread_local SmartNodeThreadCacheFlush tFlush;
+                (void)tFlush;
+
+                tThreadCache.owner = allocator;
+            }
+
+            return &tThreadCache.bins[sizeClass];
+        }
+
+        void* TakeFromThreadCache( uint32_t blockSize )
+        {
+            SmartNodeThreadCache::Bin* bin = GetThreadCacheBin( this, blockSize );
+
+            if( !bin || !bin->count )
+            {
+                return nullptr;
+            }
+
+            mCachedBytes.fetch_sub( blockSize, std::memory_order_relaxed );
+            return bin->blocks[--bin->count];
+        }
+
+        bool PutInThreadCache( SmartNodeManagerPool* pool, const void* ptr )
+        {
+            if( pool->mSizeClass == SmartNodeManagerPool::kUnlisted )
+            {
+                return false;
+            }
+
+            SmartNodeThreadCache::Bin* bin = GetThreadCacheBin( this, pool->mBlockSize );
+
+            if( !bin || bin->count == SmartNodeThreadCache::kMaxBlocks )
+            {
+                return false;
+            }
+
+            mCachedBytes.fetch_add( pool->mBlockSize, std::memory_order_relaxed );
+            bin->blocks[bin->count++] = const_cast<void*>( ptr );
+            return true;
+        }
+
+        void* AllocBlock( uint32_t blockSize )
         {
-            SmartNodeManagerPool* pool = mPools;
+            uint32_t sizeClassIdx = GetSizeClass( blockSize );
 
-            while( pool )
+            if( sizeClassIdx == SmartNodeManagerPool::kUnlisted )
             {
-                if( void* ptr = pool->TryAlloc( size, align ) )
+                // Released as soon as its block is freed
+                SmartNodeManagerPool* newPool = NewPool( SmartNodeManagerPool::HeaderSize() + blockSize, blockSize, SmartNodeManagerPool::kUnlisted );
+
+                return newPool ? newPool->TryAlloc() : nullptr;
+            }
+
+            SizeClass& sizeClass = mSizeClasses[sizeClassIdx];
+
+            if( void* ptr = AllocFromPools( sizeClass ) )
+            {
+                return ptr;
+            }
+
+            std::lock_guard lock( mMutex );
+
+            if( void* ptr = AllocFromPools( sizeClass ) )
+            {
+                return ptr;
+            }
+
+            if( SmartNodeManagerPool* newPool = NewPool( GetSlabSize(), blockSize, sizeClassIdx ) )
+            {
+                void* alloc = newPool->TryAlloc();
+                assert( alloc );
+
+                // New pools go to the front, the walk reaches pools with untouched space first
+                newPool->mNextPool.store( sizeClass.pools.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+                sizeClass.pools.store( newPool, std::memory_order_seq_cst );
+                sizeClass.current.store( newPool, std::memory_order_seq_cst );
+                return alloc;
+            }
+
+            return nullptr;
+        }
+
+        void* AllocFromPools( SizeClass& sizeClass )
+        {
+            PoolWalkGuard walk( sizeClass.walkers );
+            SmartNodeManagerPool* current = sizeClass.current.load( std::memory_order_seq_cst );
+
+            if( current )
+            {
+                if( void* ptr = current->TryAlloc() )
                 {
                     return ptr;
                 }
+            }
 
-                pool = pool->mNextPool;
+            for( SmartNodeManagerPool* pool = sizeClass.pools.load( std::memory_order_seq_cst ); pool; pool = pool->mNextPool )
+            {
+                if( pool != current )
+                {
+                    if( void* ptr = pool->TryAlloc() )
+                    {
+                        // The new block keeps the pool from being retired until current has been stored
+                        sizeClass.current.store( pool, std::memory_order_seq_cst );
+                        return ptr;
+                    }
+                }
             }
             return nullptr;
         }
 
-        void RemoveEmptyPool()
+        void FreeBlock( SmartNodeManagerPool* pool, const void* ptr )
         {
-            SmartNodeManagerPool* pool = mPools;
-            SmartNodeManagerPool* emptyPool = mPools->AllocCount() > 0 ? nullptr : mPools;
+            // Read first, the pool can be freed by another thread once this block is back
+            uint32_t sizeClassIdx = pool->mSizeClass;
+            bool sealed;
 
-            while( SmartNodeManagerPool* nextPool = pool->mNextPool.load( std::memory_order_relaxed ) )
+            if( pool->Free( ptr, sealed ) == 0 )
             {
-                int32_t allocCount = nextPool->AllocCount();
+                if( sizeClassIdx == SmartNodeManagerPool::kUnlisted )
+                {
+                    ReleaseUnlistedPool( pool );
+                }
+                else
+                {
+                    RemoveEmptyPool( mSizeClasses[sizeClassIdx] );
+                }
+            }
+        }
 
-                if( allocCount == 0 )
+        void RemoveEmptyPool( SizeClass& sizeClass )
+        {
+            std::lock_guard lock( mMutex );
+
+            SmartNodeManagerPool* pool = sizeClass.pools.load( std::memory_order_relaxed );
+            if( !pool )
+            {
+                return;
+            }
+
+            SmartNodeManagerPool* emptyPool = pool->AllocCount() > 0 ? nullptr : pool;
+
+            while( SmartNodeManagerPool* nextPool = pool->mNextPool.load( std::memory_order_relaxed ) )
+            {
+                if( nextPool->AllocCount() == 0 )
                 {
-                    if( emptyPool ) // Only remove a pool if we have 2 empty pools
+                    if( emptyPool ) // Only remove a pool if we have 2 empty pools of the same size class
                     {
-                        std::lock_guard lock( mMutex );
-
                         SmartNodeManagerPool* toRemove = nextPool;
 
                         if( toRemove->MarkForRemoval() )
                         {
-                            pool->mNextPool.store( toRemove->mNextPool.load( std::memory_order_relaxed ) );
+                            // Leave the removed pool's next link intact for threads still walking through it
+                            pool->mNextPool.store( toRemove->mNextPool.load( std::memory_order_relaxed ), std::memory_order_seq_cst );
 
-                            toRemove->~SmartNodeManagerPool();
+                            // No alloc can store a removed pool as current, so clearing it once is enough
+                            SmartNodeManagerPool* expected = toRemove;
+                            sizeClass.current.compare_exchange_strong( expected, nullptr, std::memory_order_seq_cst );
 
-                            std::free( toRemove );
+                            sizeClass.retired.push_back( toRemove );
                         }
-
-                        return;
+                        break;
                     }
 
-                    emptyPool = nextPool;                    
+                    emptyPool = nextPool;
                 }
 
                 pool = nextPool;
             }
+
+            FreeRetiredPools( sizeClass );
         }
-        
-        SmartNodeManagerPool* mPools = nullptr;
+
+        // Unlisted pools are only reachable through their own blocks, so they are freed without waiting for walkers
+        void ReleaseUnlistedPool( SmartNodeManagerPool* pool )
+        {
+            if( !pool->MarkForRemoval() )
+            {
+                return;
+            }
+
+            if( !pool->mBlockSize )
+            {
+                mLiveBytes.fetch_sub( pool->UsedBytes(), std::memory_order_relaxed );
+            }
+
+            DeletePool( pool );
+        }
+
+        // Requires mMutex
+        void FreeRetiredPools( SizeClass& sizeClass )
+        {
+            if( !sizeClass.retired.empty() && sizeClass.walkers.load( std::memory_order_seq_cst ) == 0 )
+            {
+                for( SmartNodeManagerPool* retired : sizeClass.retired )
+                {
+                    DeletePool( retired );
+                }
+
+                sizeClass.retired.clear();
+            }
+        }
+
+        SmartNodeManagerPool* NewPool( size_t allocSize, uint32_t blockSize, uint32_t sizeClassIdx )
+        {
+            if( void* poolAlloc = ::operator new( allocSize, std::align_val_t( GetSlabSize() ), std::nothrow ) )
+            {
+                mPoolCount.fetch_add( 1, std::memory_order_relaxed );
+                mPoolBytes.fetch_add( allocSize, std::memory_order_relaxed );
+
+                return new( poolAlloc ) SmartNodeManagerPool( allocSize, blockSize, sizeClassIdx );
+            }
+
+            return nullptr;
+        }
+
+        void DeletePool( SmartNodeManagerPool* pool )
+        {
+            mPoolCount.fetch_sub( 1, std::memory_order_relaxed );
+            mPoolBytes.fetch_sub( pool->mAllocSize, std::memory_order_relaxed );
+
+            pool->~SmartNodeManagerPool();
+
+            ::operator delete( pool, std::align_val_t( mSlabSize.load( std::memory_order_relaxed ) ) );
+        }
+
+        SizeClass mSizeClasses[kSizeClassCount];
+        std::atomic<size_t> mSlabSize = 0;
         mutable std::mutex mMutex;
+
+        std::atomic<uint64_t> mLiveBytes = 0;
+        std::atomic<uint64_t> mLiveAllocs = 0;
+        std::atomic<uint64_t> mCachedBytes = 0;
+        std::atomic<uint64_t> mPoolBytes = 0;
+        std::atomic<uint32_t> mPoolCount = 0;
     };
 
+    SmartNodeThreadCacheFlush::~SmartNodeThreadCacheFlush()
+    {
+        tThreadCache.flushed = true;
+
+        if( tThreadCache.owner )
+        {
+            tThreadCache.owner->FlushThreadCache( tThreadCache );
+        }
+    }
+
     static SmartNodeMemoryAllocator gMemoryAllocator;
 
+    static thread_local SmartNodeManager::ArenaScope* tActiveArenaScope = nullptr;
+
+    SmartNodeManager::ArenaScope::ArenaScope( size_t capacity ) :
+        mPrevious( tActiveArenaScope ), mArena( capacity ? gMemoryAllocator.NewArena( capacity ) : nullptr ), mRequiredSize( 0 )
+    {
+        tActiveArenaScope = this;
+    }
+
+    SmartNodeManager::ArenaScope::~ArenaScope()
+    {
+        assert( tActiveArenaScope == this ); // Arena scopes must be destroyed in reverse order on the thread that created them
+        tActiveArenaScope = mPrevious;
+
+        if( mArena )
+        {
+            gMemoryAllocator.SealArena( static_cast<SmartNodeManagerPool*>( mArena ) );
+        }
+    }
+
     void SmartNodeManager::SetMemoryPoolSize( uint32_t size )
     {
         SmartNodeMemoryAllocator::sNewPoolSize = size;
     }
 
+    SmartNodeMemoryStats SmartNodeManager::GetMemoryStats()
+    {
+        return gMemoryAllocator.GetStats();
+    }
+
     void* SmartNodeManager::Allocate( size_t size, size_t align )
     {
+        if( ArenaScope* arenaScope = tActiveArenaScope )
+        {
+            arenaScope->mRequiredSize = ( ( arenaScope->mRequiredSize + align - 1 ) & ~( align - 1 ) ) + size;
+
+            if( arenaScope->mArena )
+            {
+                SmartNodeManagerPool* arena = static_cast<SmartNodeManagerPool*>( arenaScope->mArena );
+
+                if( void* ptr = gMemoryAllocator.AllocArena( arena, size, align ) )
+                {
+                    return ptr;
+                }
+
+                // Slab full, continue the arena in a new slab if the capacity left covers this node
+                if( SmartNodeManagerPool* nextArena = gMemoryAllocator.NextArenaSlab( arena, size, align ) )
+                {
+                    arenaScope->mArena = nextArena;
+
+                    if( void* ptr = gMemoryAllocator.AllocArena( nextArena, size, align ) )
+                    {
+                        return ptr;
+                    }
+                }
+            }
+        }
+
         return gMemoryAllocator.Alloc( size, align );
     }
 
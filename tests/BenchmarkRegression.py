@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+"""Benchmark regression tracking for FastNoiseBenchmark
+
+Runs FastNoiseBenchmark with repetitions, appends the per node/dimension/feature set results to a JSON
+history file and compares them against a stored baseline. Exits with code 1 if any benchmark regressed
+beyond the threshold, so it can gate upgrades or run in CI.
+
+A benchmark counts as regressed when its median ns/sample is slower than the baseline median by more than
+--threshold percent, and the difference exceeds --mad-factor times the larger median absolute deviation
+of the two runs. This ignores differences that are within run to run noise.
+
+Only needs Python 3 and a built FastNoiseBenchmark (FASTNOISE2_TESTS=ON).
+
+Examples:
+    # Record a baseline
+    BenchmarkRegression.py --benchmark build/Release/bin/FastNoiseBenchmark --save-baseline baseline.json
+
+    # Compare against it after upgrading, failing on >5% slowdowns
+    BenchmarkRegression.py --benchmark build/Release/bin/FastNoiseBenchmark --baseline baseline.json --threshold 5
+"""
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import statistics
+import subprocess
+import sys
+import tempfile
+
+
+def run_benchmark(args):
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        out_path = os.path.join(tmp_dir, "results.json")
+        command = [
+            args.benchmark,
+            "--benchmark_repetitions=%d" % args.repetitions,
+            "--benchmark_min_time=%g" % args.min_time,
+            "--benchmark_out=" + out_path,
+            "--benchmark_out_format=json",
+        ]
+        if args.filter:
+            command.append("--benchmark_filter=" + args.filter)
+
+        print("Running: " + " ".join(command), file=sys.stderr)
+        subprocess.run(command, check=True, stdout=subprocess.DEVNULL if args.quiet else None)
+
+        with open(out_path) as file:
+            return json.load(file)
+
+
+def parse_results(benchmark_json):
+    """Groups repetitions by benchmark name, returns median and MAD of ns/sample"""
+    samples = {}
+
+    for entry in benchmark_json.get("benchmarks", []):
+        if entry.get("run_type", "iteration") != "iteration" or entry.get("error_occurred"):
+            continue
+
+        items_per_second = entry.get("items_per_second")
+        if not items_per_second:
+            continue
+
+        name = entry.get("run_name", entry["name"])
+        samples.setdefault(name, []).append(1e9 / items_per_second)
+
+    results = {}
+    for name, values in samples.items():
+        median = statistics.median(values)
+        parts = name.split("/")
+
+        results[name] = {
+            # Names are formatted as "3D/<feature set>/<group>/<node>"
+            "dimension": parts[0] if len(parts) > 3 else "",
+            "feature_set": parts[1] if len(parts) > 3 else "",
+            "node": "/".join(parts[2:]) if len(parts) > 3 else name,
+            "median_ns_per_sample": median,
+            "mad_ns_per_sample": statistics.median(abs(v - median) for v in values),
+            "repetitions": values,
+        }
+    return results
+
+
+def git_revision():
+    try:
+        return subprocess.run(["git", "rev-parse", "HEAD"], capture_output=True, text=True, check=True,
+                              cwd=os.path.dirname(os.path.abspath(__file__))).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return ""
+
+
+def cpu_name():
+    try:
+        with open("/proc/cpuinfo") as file:
+            for line in file:
+                if line.startswith("model name"):
+                    return line.split(":", 1)[1].strip()
+    except OSError:
+        pass
+    return platform.processor()
+
+
+def make_record(args, benchmark_json, results):
+    return {
+        "timestamp": datetime.datetime.now(datetime.timezone.utc).isoformat(),
+        "label": args.label,
+        "git_revision": git_revision(),
+        "cpu": cpu_name(),
+        "host": platform.node(),
+        "context": benchmark_json.get("context", {}),
+        "results": results,
+    }
+
+
+def append_history(path, record):
+    history = {"runs": []}
+    if os.path.exists(path):
+        with open(path) as file:
+            history = json.load(file)
+
+    history["runs"].append(record)
+
+    with open(path, "w") as file:
+        json.dump(history, file, indent=1)
+
+
+def compare(baseline, current, threshold, mad_factor):
+    regressions = []
+    improvements = []
+    missing = []
+
+    for name, base in sorted(baseline["results"].items()):
+        result = current["results"].get(name)
+        if result is None:
+            missing.append(name)
+            continue
+
+        base_median = base["median_ns_per_sample"]
+        median = result["median_ns_per_sample"]
+        change = (median - base_median) / base_median * 100
+        noise = mad_factor * max(base["mad_ns_per_sample"], result["mad_ns_per_sample"])
+
+        if abs(median - base_median) <= noise or abs(change) <= threshold:
+            continue
+
+        (regressions if change > 0 else improvements).append((name, base_median, median, change))
+
+    return regressions, improvements, missing
+
+
+def print_changes(title, changes):
+    if not changes:
+        return
+
+    print("\n%s:" % title)
+    print("%-60s %12s %12s %9s" % ("Benchmark", "Base ns", "Current ns", "Change"))
+    for name, base_median, median, change in changes:
+        print("%-60s %12.3f %12.3f %+8.1f%%" % (name, base_median, median, change))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--benchmark", required=True, help="Path to the FastNoiseBenchmark executable")
+    parser.add_argument("--filter", default="", help="Benchmark name regex, passed to --benchmark_filter")
+    parser.add_argument("--repetitions", type=int, default=5, help="Repetitions of each benchmark (default: 5)")
+    parser.add_argument("--min-time", type=float, default=0.1, help="Minimum seconds per repetition (default: 0.1)")
+    parser.add_argument("--history", default="FastNoiseBenchmarkHistory.json", help="JSON history file results are appended to")
+    parser.add_argument("--baseline", help="Baseline JSON file to compare against, or a history file to use its latest run")
+    parser.add_argument("--baseline-label", default="", help="When --baseline is a history file, use the latest run with this label")
+    parser.add_argument("--save-baseline", help="Write the results of this run to a baseline JSON file")
+    parser.add_argument("--threshold", type=float, default=5.0, help="Percentage slowdown that counts as a regression (default: 5)")
+    parser.add_argument("--mad-factor", type=float, default=3.0, help="Differences within this many MADs are treated as noise (default: 3)")
+    parser.add_argument("--label", default="", help="Label stored with the results, e.g. the FastNoise2 version")
+    parser.add_argument("--quiet", action="store_true", help="Hide FastNoiseBenchmark console output")
+    args = parser.parse_args()
+
+    baseline = None
+    if args.baseline:
+        # Loaded before the history is updated so a history file baseline does not include this run
+        with open(args.baseline) as file:
+            baseline = json.load(file)
+
+        if "runs" in baseline:
+            runs = [run for run in baseline["runs"] if not args.baseline_label or run.get("label") == args.baseline_label]
+            if not runs:
+                print("No baseline run found in " + args.baseline, file=sys.stderr)
+                return 2
+            baseline = runs[-1]
+
+    benchmark_json = run_benchmark(args)
+    record = make_record(args, benchmark_json, parse_results(benchmark_json))
+
+    if not record["results"]:
+        print("No benchmark results", file=sys.stderr)
+        return 2
+
+    append_history(args.history, record)
+    print("Recorded %d benchmarks to %s" % (len(record["results"]), args.history))
+
+    if args.save_baseline:
+        with open(args.save_baseline, "w") as file:
+            json.dump(record, file, indent=1)
+        print("Saved baseline to " + args.save_baseline)
+
+    if not baseline:
+        return 0
+
+    if baseline.get("cpu") != record["cpu"]:
+        print("Warning: baseline was recorded on a different CPU (%s)" % baseline.get("cpu"), file=sys.stderr)
+
+    regressions, improvements, missing = compare(baseline, record, args.threshold, args.mad_factor)
+
+    print_changes("Improvements", improvements)
+    print_changes("Regressions", regressions)
+
+    if missing:
+        print("\n%d baseline benchmarks were not run" % len(missing))
+
+    print("\n%d regressions, %d improvements beyond %.1f%%" % (len(regressions), len(improvements), args.threshold))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
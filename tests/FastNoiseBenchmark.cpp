@@ -1,46 +1,34 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
 #include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 #include "FastNoise/FastNoise.h"
 #include "FastNoise/Metadata.h"
 #include "FastSIMD/FastSIMD_FastNoise_config.h"
 
-#include "../tools/NodeEditor/util/DemoNodeTrees.inl"
+#include "PerfCounters.h"
+#include "WorkloadTrees.h"
 
 static const size_t gPositionCount = 8192;
 static float gPositionFloats[gPositionCount]; 
 
 FastNoise::SmartNode<> BuildGenerator( benchmark::State& state, const FastNoise::Metadata* metadata, FastSIMD::FeatureSet level )
-{    
-    FastNoise::SmartNode<> generator = metadata->CreateNode( level );
-
-    FastNoise::SmartNode<> source = FastNoise::New<FastNoise::Constant>( level );
+{
+    FastNoise::SmartNode<> generator = BuildMetadataNode( metadata, level );
 
-    for( const auto& memberNode : metadata->memberNodeLookups )
+    if( !generator )
     {
-        if( !memberNode.setFunc( generator.get(), source ) )
-        {
-            // If constant source is not valid try all other node types in order
-            for( const FastNoise::Metadata* tryMetadata : FastNoise::Metadata::GetAll() )
-            {
-                FastNoise::SmartNode<> trySource = tryMetadata->CreateNode( level );
-
-                // Other node types may also have sources
-                if( memberNode.setFunc( generator.get(), trySource ) )
-                {
-                    for( const auto& tryMemberNode : tryMetadata->memberNodeLookups )
-                    {
-                        if( !tryMemberNode.setFunc( trySource.get(), source ) )
-                        {
-                            state.SkipWithError( "Could not set valid sources for generator" );
-                            return {};
-                        }                        
-                    }
-                    break;
-                }
-            }
-        }
+        state.SkipWithError( "Could not set valid sources for generator" );
     }
     return generator;
 }
@@ -52,6 +40,7 @@ void BenchFastNoiseGenerator2D( benchmark::State& state, const FastNoise::SmartN
     float* data = new float[gPositionCount];
     size_t totalData = 0;
     int seed = 0;
+    PerfCounters perfCounters;
 
     for( auto _ : state )
     {
@@ -60,6 +49,7 @@ void BenchFastNoiseGenerator2D( benchmark::State& state, const FastNoise::SmartN
         totalData += gPositionCount;
     }
 
+    perfCounters.Report( state, totalData );
     delete[] data;
     state.SetItemsProcessed( totalData );
 }
@@ -71,6 +61,7 @@ void BenchFastNoiseGenerator3D( benchmark::State& state, const FastNoise::SmartN
     float* data = new float[gPositionCount];
     size_t totalData = 0;
     int seed = 0;
+    PerfCounters perfCounters;
 
     for( auto _ : state )
     {
@@ -79,6 +70,7 @@ void BenchFastNoiseGenerator3D( benchmark::State& state, const FastNoise::SmartN
         totalData += gPositionCount;
     }
 
+    perfCounters.Report( state, totalData );
     delete[] data;
     state.SetItemsProcessed( totalData );
 }
@@ -90,6 +82,7 @@ void BenchFastNoiseGenerator4D( benchmark::State& state, const FastNoise::SmartN
     float* data = new float[gPositionCount];
     size_t totalData = 0;
     int seed = 0;
+    PerfCounters perfCounters;
 
     for( auto _ : state )
     {
@@ -98,6 +91,7 @@ void BenchFastNoiseGenerator4D( benchmark::State& state, const FastNoise::SmartN
         totalData += gPositionCount;
     }
 
+    perfCounters.Report( state, totalData );
     delete[] data;
     state.SetItemsProcessed( totalData );
 }
@@ -122,17 +116,276 @@ void RegisterBenchmarks( FastSIMD::FeatureSet level, const char* groupName, cons
     benchmark::RegisterBenchmark( benchName.c_str(), [=]( benchmark::State& st ) { BenchFastNoiseGenerator2D( st, generatorFunc( st ) ); } );
 }
 
-int main( int argc, char** argv )
+void GeneratePositionArray( const FastNoise::SmartNode<>& generator, std::vector<float>& data, int dimensions, int seed )
 {
-    std::cout << "FastSIMD Max Supported Feature Set: " << FastSIMD::GetFeatureSetString( FastSIMD::DetectCpuMaxFeatureSet() ) << std::endl;
+    switch( dimensions )
+    {
+    case 2:
+        generator->GenPositionArray2D( data.data(), gPositionCount, gPositionFloats, gPositionFloats, 0, 0, seed );
+        break;
+    case 3:
+        generator->GenPositionArray3D( data.data(), gPositionCount, gPositionFloats, gPositionFloats, gPositionFloats, 0, 0, 0, seed );
+        break;
+    case 4:
+        generator->GenPositionArray4D( data.data(), gPositionCount, gPositionFloats, gPositionFloats, gPositionFloats, gPositionFloats, 0, 0, 0, 0, seed );
+        break;
+    }
+}
 
-    benchmark::Initialize( &argc, argv );
+float MeasureSampleCost( const FastNoise::SmartNode<>& generator, int dimensions )
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<float> data( gPositionCount );
+    size_t totalData = 0;
+    int seed = 0;
+
+    Clock::time_point start = Clock::now();
+    Clock::duration elapsed;
+
+    do
+    {
+        GeneratePositionArray( generator, data, dimensions, seed++ );
+        totalData += gPositionCount;
+        elapsed = Clock::now() - start;
+    }
+    while( elapsed < std::chrono::milliseconds( 50 ) );
+
+    return (float)std::chrono::duration<double, std::nano>( elapsed ).count() / (float)totalData;
+}
+
+// Source nodes evaluated per generated sample, from the node profiler, keyed by feature set, node name and dimension count
+// Fractal sources are evaluated once per octave, so sources are counted per evaluation not per member
+using SourceCounts = std::map<std::string, std::vector<std::pair<std::string, double>>>;
 
+std::string SourceCountsKey( FastSIMD::FeatureSet level, const FastNoise::Metadata* metadata, int dimensions )
+{
+    return std::string( FastSIMD::GetFeatureSetString( level ) ) + ' ' + metadata->name + ' ' + std::to_string( dimensions );
+}
+
+// Prints the source evaluations of each node built by BuildMetadataNode, one line per source node type
+// Format: feature set, node name, dimensions, source node name, evaluations per sample
+// Requires a FASTNOISE2_PROFILING build, the counts are read back by --calibrate_cost in a build without profiling
+int CountNodeSources()
+{
+    if( !FastNoise::NodeProfiler::IsAvailable() )
+    {
+        std::cerr << "--count_sources requires FastNoise built with FASTNOISE2_PROFILING=ON" << std::endl;
+        return 1;
+    }
+
+    std::vector<float> data( gPositionCount );
+    std::cout << std::setprecision( 9 );
+
+    for( auto level : FastSIMD::FastSIMD_FastNoise::CompiledFeatureSets::AsArray )
+    {
+        for( const FastNoise::Metadata* metadata : FastNoise::Metadata::GetAll() )
+        {
+            FastNoise::SmartNode<> generator = BuildMetadataNode( metadata, level );
+
+            if( !generator || generator->GetActiveFeatureSet() != level )
+            {
+                continue;
+            }
+
+            for( int dimensions = 2; dimensions <= 4; dimensions++ )
+            {
+                FastNoise::NodeProfiler::Begin();
+                GeneratePositionArray( generator, data, dimensions, 0 );
+                FastNoise::NodeProfiler::End();
+
+                std::vector<std::pair<std::string, double>> sources;
+
+                for( const FastNoise::NodeProfile& profile : FastNoise::NodeProfiler::GetResults( generator.get() ) )
+                {
+                    if( profile.depth > 0 )
+                    {
+                        sources.emplace_back( profile.metadata->name, (double)profile.samples );
+                    }
+                }
+
+                std::sort( sources.begin(), sources.end() );
+
+                for( size_t i = 0; i < sources.size(); i++ )
+                {
+                    double samples = sources[i].second;
+
+                    while( i + 1 < sources.size() && sources[i + 1].first == sources[i].first )
+                    {
+                        samples += sources[++i].second;
+                    }
+
+                    std::cout << SourceCountsKey( level, metadata, dimensions ) << ' ' << sources[i].first << ' '
+                              << samples / (double)gPositionCount << '\n';
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+bool LoadSourceCounts( const char* path, SourceCounts& counts )
+{
+    std::ifstream file( path );
+
+    if( !file )
+    {
+        return false;
+    }
+
+    std::string level, nodeName, dimensions, sourceName;
+    double evaluations;
+
+    while( file >> level >> nodeName >> dimensions >> sourceName >> evaluations )
+    {
+        counts[level + ' ' + nodeName + ' ' + dimensions].emplace_back( sourceName, evaluations );
+    }
+    return file.eof();
+}
+
+// Cost of the source nodes per generated sample, from the source evaluations counted by --count_sources
+float MeasureSourceCost( const std::vector<std::pair<std::string, double>>& sources, int dimensions, const std::vector<std::array<float, 3>>& levelCosts )
+{
+    double sourceCost = 0;
+
+    for( const auto& source : sources )
+    {
+        for( const FastNoise::Metadata* metadata : FastNoise::Metadata::GetAll() )
+        {
+            if( source.first == metadata->name )
+            {
+                sourceCost += source.second * levelCosts[metadata->id][dimensions - 2];
+                break;
+            }
+        }
+    }
+
+    return (float)sourceCost;
+}
+
+// Prints the per sample cost of each node type in the format of src/FastNoise/NodeCostTable.inl
+// Source nodes are Constant where possible, the cost of every source evaluation is subtracted
+// Source evaluations come from --count_sources, timings must come from a build without FASTNOISE2_PROFILING
+int CalibrateNodeCosts( const char* sourceCountsPath )
+{
+    if( FastNoise::NodeProfiler::IsAvailable() )
+    {
+        std::cerr << "--calibrate_cost requires FastNoise built with FASTNOISE2_PROFILING=OFF, profiling instrumentation skews timings" << std::endl;
+        return 1;
+    }
+
+    SourceCounts sourceCounts;
+
+    if( !LoadSourceCounts( sourceCountsPath, sourceCounts ) )
+    {
+        std::cerr << "Could not read source counts from: " << sourceCountsPath << std::endl;
+        return 1;
+    }
+
+    std::cout << "// Per sample generation cost of each node type in nanoseconds, excluding the cost of source nodes\n"
+                 "// Format: { node name, feature set name or nullptr, { 2D, 3D, 4D } }\n"
+                 "// Rows with a nullptr feature set are used for feature sets without a calibrated row\n"
+                 "// Regenerate by running: FastNoiseBenchmark --count_sources > source_counts.txt in a FASTNOISE2_PROFILING build\n"
+                 "// Then: FastNoiseBenchmark --calibrate_cost=source_counts.txt > src/FastNoise/NodeCostTable.inl in a normal build\n"
+                 "// Calibrated on CPU max feature set: " << FastSIMD::GetFeatureSetString( FastSIMD::DetectCpuMaxFeatureSet() ) << "\n";
+
+    // Highest measured feature set is used for estimates
+    std::vector<std::array<float, 3>> estimateCosts( FastNoise::Metadata::GetAll().size() );
+
+    std::cout << std::fixed << std::setprecision( 3 );
+
+    for( auto level : FastSIMD::FastSIMD_FastNoise::CompiledFeatureSets::AsArray )
+    {
+        FastNoise::SmartNode<> constant = FastNoise::New<FastNoise::Constant>( level );
+
+        if( !constant || constant->GetActiveFeatureSet() != level )
+        {
+            continue;
+        }
+
+        std::cout << "\n";
+
+        // Costs measured so far on this feature set, Constant first since it is the source for most nodes
+        // Source nodes that have not been measured yet count as free
+        std::vector<std::array<float, 3>> levelCosts( FastNoise::Metadata::GetAll().size(), std::array<float, 3>{} );
+
+        for( int dimensions = 2; dimensions <= 4; dimensions++ )
+        {
+            levelCosts[constant->GetMetadata().id][dimensions - 2] = MeasureSampleCost( constant, dimensions );
+        }
+
+        for( const FastNoise::Metadata* metadata : FastNoise::Metadata::GetAll() )
+        {
+            FastNoise::SmartNode<> generator = BuildMetadataNode( metadata, level );
+
+            if( !generator )
+            {
+                continue;
+            }
+
+            std::array<float, 3> costs;
+            for( int dimensions = 2; dimensions <= 4; dimensions++ )
+            {
+                auto sources = sourceCounts.find( SourceCountsKey( level, metadata, dimensions ) );
+
+                if( sources == sourceCounts.end() )
+                {
+                    std::cerr << "No source counts for: " << SourceCountsKey( level, metadata, dimensions ) << std::endl;
+                    return 1;
+                }
+
+                float sourceCost = MeasureSourceCost( sources->second, dimensions, levelCosts );
+
+                costs[dimensions - 2] = std::max( MeasureSampleCost( generator, dimensions ) - sourceCost, 0.01f );
+            }
+
+            levelCosts[metadata->id] = costs;
+            estimateCosts[metadata->id] = costs;
+            std::cout << "{ \"" << metadata->name << "\", \"" << FastSIMD::GetFeatureSetString( level ) << "\", { "
+                      << costs[0] << "f, " << costs[1] << "f, " << costs[2] << "f } },\n";
+        }
+    }
+
+    // Estimates for feature sets that could not be measured on this CPU
+    std::cout << "\n";
+    for( const FastNoise::Metadata* metadata : FastNoise::Metadata::GetAll() )
+    {
+        const std::array<float, 3>& costs = estimateCosts[metadata->id];
+
+        if( costs[0] > 0 )
+        {
+            std::cout << "{ \"" << metadata->name << "\", nullptr, { "
+                      << costs[0] << "f, " << costs[1] << "f, " << costs[2] << "f } },\n";
+        }
+    }
+    return 0;
+}
+
+int main( int argc, char** argv )
+{
     for( size_t idx = 0; idx < gPositionCount; idx++ )
     {
         gPositionFloats[idx] = (float)idx * 0.6f;
     }
-    
+
+    // Output is redirected into NodeCostTable.inl or the source counts file, so nothing else is printed to stdout
+    for( int i = 1; i < argc; i++ )
+    {
+        if( std::strncmp( argv[i], "--calibrate_cost=", 17 ) == 0 )
+        {
+            return CalibrateNodeCosts( argv[i] + 17 );
+        }
+        if( std::strcmp( argv[i], "--count_sources" ) == 0 )
+        {
+            return CountNodeSources();
+        }
+    }
+
+    std::cout << "FastSIMD Max Supported Feature Set: " << FastSIMD::GetFeatureSetString( FastSIMD::DetectCpuMaxFeatureSet() ) << std::endl;
+
+    PerfCounters::ParseArguments( argc, argv );
+    benchmark::Initialize( &argc, argv );
+
     for( auto level : FastSIMD::FastSIMD_FastNoise::CompiledFeatureSets::AsArray )
     {
         for( const FastNoise::Metadata* metadata : FastNoise::Metadata::GetAll() )
@@ -0,0 +1,435 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "FastNoise/FastNoise.h"
+#include "FastNoise/Metadata.h"
+#include "FastSIMD/FastSIMD_FastNoise_config.h"
+
+#include "WorkloadTrees.h"
+
+// Generates every node type and demo node tree on every compiled SIMD feature set supported by the CPU
+// and compares the output against the lowest feature set, then reports the throughput of each feature set
+// Strict FP builds (FASTNOISE2_STRICT_FP) must match exactly, relaxed builds must match within a ULP or absolute tolerance
+// Exits with 1 if any output differs beyond the tolerance
+//
+// To measure the cost of strict FP, save results from a relaxed build and compare from a strict build (or the reverse):
+//   relaxed build: FastNoiseFeatureSetCompare --save=relaxed.csv
+//   strict build:  FastNoiseFeatureSetCompare --compare=relaxed.csv
+//
+// Options:
+//   --filter=<text>   Only run nodes with names containing text
+//   --max-ulp=256     Relaxed mode ULP tolerance
+//   --max-abs=1e-4    Relaxed mode absolute tolerance, differences within either tolerance pass
+//   --ms=20           Measurement time per node, dimension and feature set in milliseconds
+//   --save=<file>     Write ns/sample results to a CSV file
+//   --compare=<file>  Report the strict FP cost against results saved from a build with the other FP mode
+
+#ifdef FASTNOISE2_STRICT_FP
+static constexpr bool kStrictFP = true;
+#else
+static constexpr bool kStrictFP = false;
+#endif
+
+static const int kGridCount[] = { 64, 16, 8 }; // Per axis for 2D, 3D, 4D, 4096 samples each
+static const size_t kScatterCount = 4096;
+
+struct Options
+{
+    std::string filter;
+    int64_t maxUlp = 256;
+    float maxAbs = 1e-4f;
+    double ms = 20;
+    std::string saveFile;
+    std::string compareFile;
+};
+
+struct TestCase
+{
+    std::string name;
+    std::function<FastNoise::SmartNode<>( FastSIMD::FeatureSet )> create;
+};
+
+struct DiffResult
+{
+    size_t mismatches = 0;
+    int64_t maxUlp = 0;
+    float maxAbs = 0;
+};
+
+// Maps float bits onto a monotonic integer line so the difference is the ULP distance
+static int64_t FloatToOrdered( float f )
+{
+    int32_t i;
+    std::memcpy( &i, &f, sizeof( i ) );
+    return i < 0 ? (int64_t)INT32_MIN - i : i;
+}
+
+static DiffResult Diff( const std::vector<float>& reference, const std::vector<float>& values, const Options& options )
+{
+    DiffResult result;
+
+    for( size_t i = 0; i < reference.size(); i++ )
+    {
+        float a = reference[i];
+        float b = values[i];
+
+        if( std::isnan( a ) || std::isnan( b ) )
+        {
+            if( std::isnan( a ) != std::isnan( b ) )
+            {
+                result.mismatches++;
+                result.maxUlp = INT32_MAX;
+                result.maxAbs = FastNoise::kInfinity;
+            }
+            continue;
+        }
+
+        int64_t ulp = std::abs( FloatToOrdered( a ) - FloatToOrdered( b ) );
+        float absDiff = std::abs( a - b );
+
+        result.maxUlp = std::max( result.maxUlp, ulp );
+        result.maxAbs = std::max( result.maxAbs, absDiff );
+
+        if( kStrictFP ? ulp != 0 : ( ulp > options.maxUlp && absDiff > options.maxAbs ) )
+        {
+            result.mismatches++;
+        }
+    }
+    return result;
+}
+
+static std::vector<float> GeneratePositions( size_t count, uint32_t seed, float range )
+{
+    std::vector<float> positions( count );
+
+    for( float& position : positions )
+    {
+        seed = seed * 1664525u + 1013904223u;
+        position = ( (float)( seed >> 8 ) / (float)( 1 << 24 ) * 2.0f - 1.0f ) * range;
+    }
+    return positions;
+}
+
+// Uniform grid followed by positions scattered over a large range to include precision sensitive inputs
+static std::vector<float> GenerateOutput( const FastNoise::SmartNode<>& generator, int dimensions, const std::vector<float> ( &scatter )[4] )
+{
+    int count = kGridCount[dimensions - 2];
+    size_t gridSize = 1;
+    for( int i = 0; i < dimensions; i++ )
+    {
+        gridSize *= count;
+    }
+
+    std::vector<float> output( gridSize + kScatterCount );
+    float* scatterOut = output.data() + gridSize;
+
+    switch( dimensions )
+    {
+    case 2:
+        generator->GenUniformGrid2D( output.data(), -12.3f, 4.5f, count, count, 0.37f, 0.41f, 1337 );
+        generator->GenPositionArray2D( scatterOut, (int)kScatterCount, scatter[0].data(), scatter[1].data(), 0, 0, 1337 );
+        break;
+    case 3:
+        generator->GenUniformGrid3D( output.data(), -12.3f, 4.5f, 7.7f, count, count, count, 0.37f, 0.41f, 0.29f, 1337 );
+        generator->GenPositionArray3D( scatterOut, (int)kScatterCount, scatter[0].data(), scatter[1].data(), scatter[2].data(), 0, 0, 0, 1337 );
+        break;
+    case 4:
+        generator->GenUniformGrid4D( output.data(), -12.3f, 4.5f, 7.7f, -3.1f, count, count, count, count, 0.37f, 0.41f, 0.29f, 0.53f, 1337 );
+        generator->GenPositionArray4D( scatterOut, (int)kScatterCount, scatter[0].data(), scatter[1].data(), scatter[2].data(), scatter[3].data(), 0, 0, 0, 0, 1337 );
+        break;
+    }
+    return output;
+}
+
+static double MeasureNsPerSample( const FastNoise::SmartNode<>& generator, int dimensions, const std::vector<float> ( &scatter )[4], double ms )
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<float> output( kScatterCount );
+    size_t totalSamples = 0;
+    int seed = 0;
+
+    Clock::time_point start = Clock::now();
+    Clock::duration elapsed;
+
+    do
+    {
+        switch( dimensions )
+        {
+        case 2:
+            generator->GenPositionArray2D( output.data(), (int)kScatterCount, scatter[0].data(), scatter[1].data(), 0, 0, seed++ );
+            break;
+        case 3:
+            generator->GenPositionArray3D( output.data(), (int)kScatterCount, scatter[0].data(), scatter[1].data(), scatter[2].data(), 0, 0, 0, seed++ );
+            break;
+        case 4:
+            generator->GenPositionArray4D( output.data(), (int)kScatterCount, scatter[0].data(), scatter[1].data(), scatter[2].data(), scatter[3].data(), 0, 0, 0, 0, seed++ );
+            break;
+        }
+        totalSamples += kScatterCount;
+        elapsed = Clock::now() - start;
+    }
+    while( elapsed < std::chrono::duration<double, std::milli>( ms ) );
+
+    return std::chrono::duration<double, std::nano>( elapsed ).count() / (double)totalSamples;
+}
+
+static bool ParseOptions( int argc, char** argv, Options& options )
+{
+    for( int i = 1; i < argc; i++ )
+    {
+        std::string arg = argv[i];
+        size_t equals = arg.find( '=' );
+        std::string key = arg.substr( 0, equals );
+        std::string value = equals == std::string::npos ? "" : arg.substr( equals + 1 );
+
+        if( key == "--filter" )
+        {
+            options.filter = value;
+        }
+        else if( key == "--max-ulp" )
+        {
+            options.maxUlp = std::stoll( value );
+        }
+        else if( key == "--max-abs" )
+        {
+            options.maxAbs = std::stof( value );
+        }
+        else if( key == "--ms" )
+        {
+            options.ms = std::stod( value );
+        }
+        else if( key == "--save" )
+        {
+            options.saveFile = value;
+        }
+        else if( key == "--compare" )
+        {
+            options.compareFile = value;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+using ResultKey = std::tuple<std::string, int, std::string>; // { name, dimensions, feature set }
+
+// Returns ns/sample results keyed by name, dimensions and feature set, and whether they were saved from a strict FP build
+static bool LoadResults( const std::string& path, std::map<ResultKey, double>& results, bool& strictFP )
+{
+    std::ifstream file( path );
+    std::string line;
+
+    if( !file || !std::getline( file, line ) || line.rfind( "# strict_fp=", 0 ) != 0 )
+    {
+        return false;
+    }
+    strictFP = line.back() == '1';
+
+    std::getline( file, line ); // Header
+
+    while( std::getline( file, line ) )
+    {
+        // Name is quoted and may contain commas
+        size_t nameEnd = line.rfind( "\"," );
+        if( line.empty() || line[0] != '"' || nameEnd == std::string::npos )
+        {
+            continue;
+        }
+
+        std::string name = line.substr( 1, nameEnd - 1 );
+        std::stringstream rest( line.substr( nameEnd + 2 ) );
+        std::string dimensions, featureSet, ns;
+
+        std::getline( rest, dimensions, ',' );
+        std::getline( rest, featureSet, ',' );
+        std::getline( rest, ns, ',' );
+
+        results[{ name, std::stoi( dimensions ), featureSet }] = std::stod( ns );
+    }
+    return true;
+}
+
+int main( int argc, char** argv )
+{
+    Options options;
+
+    if( !ParseOptions( argc, argv, options ) )
+    {
+        return 1;
+    }
+
+    std::map<ResultKey, double> compareResults;
+    bool compareStrictFP = false;
+
+    if( !options.compareFile.empty() )
+    {
+        if( !LoadResults( options.compareFile, compareResults, compareStrictFP ) )
+        {
+            std::cerr << "Could not load results from: " << options.compareFile << std::endl;
+            return 1;
+        }
+
+        if( compareStrictFP == kStrictFP )
+        {
+            std::cerr << "Compare file was saved from a build with the same FP mode, strict FP cost is not meaningful" << std::endl;
+        }
+    }
+
+    // Feature sets the CPU can run, the first is the reference output
+    std::vector<FastSIMD::FeatureSet> levels;
+
+    for( auto level : FastSIMD::FastSIMD_FastNoise::CompiledFeatureSets::AsArray )
+    {
+        FastNoise::SmartNode<> probe = FastNoise::New<FastNoise::Constant>( level );
+
+        if( probe && probe->GetActiveFeatureSet() == level )
+        {
+            levels.push_back( level );
+        }
+    }
+
+    if( levels.empty() )
+    {
+        std::cerr << "No compiled feature sets are supported by this CPU" << std::endl;
+        return 1;
+    }
+
+    std::vector<TestCase> testCases;
+
+    for( const FastNoise::Metadata* metadata : FastNoise::Metadata::GetAll() )
+    {
+        testCases.push_back( { FastNoise::Metadata::FormatMetadataNodeName( metadata ), [metadata]( FastSIMD::FeatureSet level ) { return BuildMetadataNode( metadata, level ); } } );
+    }
+
+    for( const auto& nodeTree : gDemoNodeTrees )
+    {
+        const char* encodedTree = nodeTree[1];
+
+        testCases.push_back( { std::string( "Node Trees/" ) + nodeTree[0], [encodedTree]( FastSIMD::FeatureSet level ) { return FastNoise::NewFromEncodedNodeTree( encodedTree, level ); } } );
+    }
+
+    const std::vector<float> scatter[4] =
+    {
+        GeneratePositions( kScatterCount, 1, 5000.0f ),
+        GeneratePositions( kScatterCount, 2, 5000.0f ),
+        GeneratePositions( kScatterCount, 3, 5000.0f ),
+        GeneratePositions( kScatterCount, 4, 5000.0f ),
+    };
+
+    std::ofstream saveFile;
+    if( !options.saveFile.empty() )
+    {
+        saveFile.open( options.saveFile );
+        saveFile << "# strict_fp=" << ( kStrictFP ? 1 : 0 ) << "\nname,dimensions,feature_set,ns_per_sample\n";
+    }
+
+    std::cout << ( kStrictFP ? "Strict FP build, outputs must match exactly" : "Relaxed FP build, outputs must match within tolerance" ) << "\n";
+    std::cout << "Reference feature set: " << FastSIMD::GetFeatureSetString( levels[0] ) << "\n\n";
+
+    std::printf( "%-40s %-4s %-12s %8s %12s %12s", "Node", "Dims", "Feature Set", "Result", "Max ULP", "Max Abs" );
+    std::printf( " %10s", "ns/sample" );
+    if( !compareResults.empty() )
+    {
+        std::printf( " %12s", "Strict cost" );
+    }
+    std::printf( "\n" );
+
+    size_t failures = 0;
+    size_t skipped = 0;
+
+    for( const TestCase& testCase : testCases )
+    {
+        if( testCase.name.find( options.filter ) == std::string::npos )
+        {
+            continue;
+        }
+
+        for( int dimensions = 2; dimensions <= 4; dimensions++ )
+        {
+            std::vector<float> reference;
+
+            for( FastSIMD::FeatureSet level : levels )
+            {
+                FastNoise::SmartNode<> generator = testCase.create( level );
+                const char* levelName = FastSIMD::GetFeatureSetString( level );
+
+                if( !generator )
+                {
+                    if( dimensions == 2 && level == levels[0] )
+                    {
+                        std::printf( "%-40s Could not create node\n", testCase.name.c_str() );
+                        skipped++;
+                    }
+                    break;
+                }
+
+                std::vector<float> output = GenerateOutput( generator, dimensions, scatter );
+                const char* result = "Ref";
+                DiffResult diff;
+
+                if( reference.empty() )
+                {
+                    reference = std::move( output );
+                }
+                else
+                {
+                    diff = Diff( reference, output, options );
+                    result = diff.mismatches ? "FAIL" : "Pass";
+                    failures += diff.mismatches ? 1 : 0;
+                }
+
+                double ns = MeasureNsPerSample( generator, dimensions, scatter, options.ms );
+
+                std::printf( "%-40s %-4d %-12s %8s %12lld %12g %10.3f", testCase.name.c_str(), dimensions, levelName, result, (long long)diff.maxUlp, diff.maxAbs, ns );
+
+                if( !compareResults.empty() )
+                {
+                    auto find = compareResults.find( { testCase.name, dimensions, levelName } );
+
+                    if( find != compareResults.end() && find->second > 0 && ns > 0 )
+                    {
+                        double cost = kStrictFP ? ns / find->second : find->second / ns;
+                        std::printf( " %11.1f%%", ( cost - 1.0 ) * 100.0 );
+                    }
+                }
+
+                if( diff.mismatches )
+                {
+                    std::printf( "  %zu of %zu samples differ", diff.mismatches, reference.size() );
+                }
+                std::printf( "\n" );
+
+                if( saveFile )
+                {
+                    saveFile << '"' << testCase.name << "\"," << dimensions << ',' << levelName << ',' << ns << '\n';
+                }
+            }
+        }
+    }
+
+    std::cout << "\n" << failures << " feature set outputs differ from the reference";
+    if( skipped )
+    {
+        std::cout << ", " << skipped << " nodes could not be created";
+    }
+    std::cout << std::endl;
+
+    return failures ? 1 : 0;
+}
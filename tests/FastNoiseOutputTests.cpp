@@ -0,0 +1,1118 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "FastNoise/FastNoise.h"
+#include "FastNoise/FastNoise_C.h"
+#include "FastNoise/Metadata.h"
+#include "FastSIMD/FastSIMD_FastNoise_config.h"
+
+#include "WorkloadTrees.h"
+
+// Checks that optimised generation and serialisation paths give the same output as the reference path they replace
+// Runs on every compiled SIMD feature set supported by the CPU
+// Exits with 1 if any check fails
+
+#ifdef FASTNOISE2_STRICT_FP
+static constexpr bool kStrictFP = true;
+#else
+static constexpr bool kStrictFP = false;
+#endif
+
+static int gFailures = 0;
+
+static void Check( bool passed, const std::string& name )
+{
+    if( !passed )
+    {
+        gFailures++;
+    }
+    std::cout << ( passed ? "PASS " : "FAIL " ) << name << "\n";
+}
+
+// 2D, 3D and 4D uniform grids at an offset and step that cover many lattice cells
+static std::vector<float> GenerateGrids( const FastNoise::SmartNode<>& node, int seed )
+{
+    std::vector<float> output;
+    std::vector<float> noise( 64 * 64 );
+
+    node->GenUniformGrid2D( noise.data(), -13.7f, 4.2f, 64, 64, 0.73f, 0.73f, seed );
+    output.insert( output.end(), noise.begin(), noise.end() );
+
+    node->GenUniformGrid3D( noise.data(), 2.1f, -7.9f, 11.3f, 16, 16, 16, 1.37f, 1.37f, 1.37f, seed );
+    output.insert( output.end(), noise.begin(), noise.begin() + 16 * 16 * 16 );
+
+    node->GenUniformGrid4D( noise.data(), -5.5f, 3.3f, 0.6f, 9.1f, 8, 8, 8, 8, 2.9f, 2.9f, 2.9f, 2.9f, seed );
+    output.insert( output.end(), noise.begin(), noise.begin() + 8 * 8 * 8 * 8 );
+
+    return output;
+}
+
+static bool BitExact( const std::vector<float>& a, const std::vector<float>& b )
+{
+    return a.size() == b.size() && std::memcmp( a.data(), b.data(), a.size() * sizeof( float ) ) == 0;
+}
+
+// Strict FP builds must match exactly, relaxed (fast math) builds may differ by FMA contraction and reassociation
+static bool MatchesAcrossFeatureSets( const std::vector<float>& a, const std::vector<float>& b )
+{
+    if( kStrictFP || a.size() != b.size() )
+    {
+        return BitExact( a, b );
+    }
+
+    for( size_t i = 0; i < a.size(); i++ )
+    {
+        if( !( std::abs( a[i] - b[i] ) <= 1e-4f ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 4D Simplex gradients use table lookups on AVX2 and AVX512_F and a masked increment chain on other feature sets
+// Both select the same gradient values, so every feature set must match the lowest one
+static void TestSimplex4DGradients( const std::vector<FastSIMD::FeatureSet>& levels )
+{
+    using SourceFactory = std::function<FastNoise::SmartNode<>( FastSIMD::FeatureSet )>;
+
+    const std::pair<const char*, SourceFactory> sources[] = {
+        { "Simplex", []( FastSIMD::FeatureSet level ) { return FastNoise::New<FastNoise::Simplex>( level ); } },
+        { "SuperSimplex", []( FastSIMD::FeatureSet level ) { return FastNoise::New<FastNoise::SuperSimplex>( level ); } },
+    };
+
+    auto generate = []( const FastNoise::SmartNode<>& node )
+    {
+        std::vector<float> output( 16 * 16 * 16 * 16 + 64 * 64 );
+
+        node->GenUniformGrid4D( output.data(), -5.5f, 3.3f, 0.6f, 9.1f, 16, 16, 16, 16, 7.3f, 7.3f, 7.3f, 7.3f, 1337 );
+        node->GenTileable2D( output.data() + 16 * 16 * 16 * 16, 64, 64, 3.1f, 3.1f, 1337 ); // Generated in 4D
+        return output;
+    };
+
+    for( auto& source : sources )
+    {
+        std::vector<float> reference = generate( source.second( levels[0] ) );
+
+        for( size_t i = 1; i < levels.size(); i++ )
+        {
+            Check( MatchesAcrossFeatureSets( reference, generate( source.second( levels[i] ) ) ),
+                std::string( "Simplex4DGradients/" ) + source.first + "/" + FastSIMD::GetFeatureSetString( levels[i] ) + " vs " + FastSIMD::GetFeatureSetString( levels[0] ) );
+        }
+    }
+}
+
+// Domain warp nodes generate Perlin, Simplex and SuperSimplex sources inline
+// A unit DomainScale between the warp and the source forces the generic virtual call path with identical positions
+static void TestDomainWarpInlineSource( FastSIMD::FeatureSet level )
+{
+    using WarpFactory = std::function<FastNoise::SmartNode<FastNoise::DomainWarp>()>;
+    using SourceFactory = std::function<FastNoise::SmartNode<>()>;
+
+    const std::pair<const char*, WarpFactory> warps[] = {
+        { "DomainWarpGradient", [level] { return FastNoise::New<FastNoise::DomainWarpGradient>( level ); } },
+        { "DomainWarpSimplex", [level] { return FastNoise::New<FastNoise::DomainWarpSimplex>( level ); } },
+        { "DomainWarpSuperSimplex", [level] { return FastNoise::New<FastNoise::DomainWarpSuperSimplex>( level ); } },
+    };
+
+    const std::pair<const char*, SourceFactory> sources[] = {
+        { "Perlin", [level] { return FastNoise::New<FastNoise::Perlin>( level ); } },
+        { "Simplex", [level] { return FastNoise::New<FastNoise::Simplex>( level ); } },
+        { "SuperSimplex", [level] { return FastNoise::New<FastNoise::SuperSimplex>( level ); } },
+    };
+
+    for( auto& warp : warps )
+    {
+        for( auto& source : sources )
+        {
+            auto inlined = warp.second();
+            inlined->SetSource( source.second() );
+
+            auto scale = FastNoise::New<FastNoise::DomainScale>( level );
+            scale->SetScaling( 1.0f );
+            scale->SetSource( source.second() );
+
+            auto generic = warp.second();
+            generic->SetSource( scale );
+
+            Check( BitExact( GenerateGrids( inlined, 1337 ), GenerateGrids( generic, 1337 ) ),
+                std::string( "DomainWarpInlineSource/" ) + warp.first + "/" + source.first + "/" + FastSIMD::GetFeatureSetString( level ) );
+        }
+    }
+}
+
+// Positions for blend tests: a run of vectors fully on the first branch, a run fully on the last, then cycling
+// through every branch so vectors of any width mix lanes from several branches
+static void GenerateBlendPositions( const std::vector<float>& branchX, std::vector<float>& xs, std::vector<float>& ys )
+{
+    xs.clear();
+    ys.clear();
+
+    for( int i = 0; i < 96; i++ )
+    {
+        xs.push_back( i < 32 ? branchX.front() : i < 64 ? branchX.back() : branchX[i % branchX.size()] );
+        ys.push_back( (float)i * 0.37f );
+    }
+}
+
+static std::vector<float> GeneratePositions2D( const FastNoise::SmartNode<>& node, const std::vector<float>& xs, const std::vector<float>& ys )
+{
+    std::vector<float> output( xs.size() );
+
+    node->GenPositionArray2D( output.data(), (int)output.size(), xs.data(), ys.data(), 0, 0, 1337 );
+    return output;
+}
+
+// Generates each position with every lane of the vector at that position, so no vector mixes positions
+static std::vector<float> GenerateEachPosition2D( const FastNoise::SmartNode<>& node, const std::vector<float>& xs, const std::vector<float>& ys )
+{
+    std::vector<float> output;
+
+    for( size_t i = 0; i < xs.size(); i++ )
+    {
+        std::vector<float> laneX( 64, xs[i] ), laneY( 64, ys[i] );
+
+        output.push_back( GeneratePositions2D( node, laneX, laneY )[0] );
+    }
+    return output;
+}
+
+// Fade outputs A or B exactly in lanes at or beyond Fade Min or Fade Max, whether the whole vector takes the
+// single source fast path or shares the vector with blended lanes
+static void TestFadeSaturatedLanes( FastSIMD::FeatureSet level )
+{
+    auto gradient = FastNoise::New<FastNoise::Gradient>( level );
+    gradient->SetMultiplier<FastNoise::Dim::X>( 1.0f );
+
+    auto a = FastNoise::New<FastNoise::Perlin>( level );
+    auto b = FastNoise::New<FastNoise::Simplex>( level );
+
+    auto fade = FastNoise::New<FastNoise::Fade>( level );
+    fade->SetA( a );
+    fade->SetB( b );
+    fade->SetFade( gradient );
+    fade->SetFadeMin( 0.0f );
+    fade->SetFadeMax( 1.0f );
+
+    std::vector<float> xs, ys;
+    GenerateBlendPositions( { -1.0f, 0.5f, 2.0f }, xs, ys );
+
+    std::vector<float> output = GeneratePositions2D( fade, xs, ys );
+    std::vector<float> aOutput = GeneratePositions2D( a, xs, ys );
+    std::vector<float> bOutput = GeneratePositions2D( b, xs, ys );
+
+    bool saturated = true;
+    for( size_t i = 0; i < xs.size(); i++ )
+    {
+        if( ( xs[i] <= 0.0f && std::memcmp( &output[i], &aOutput[i], sizeof( float ) ) != 0 ) ||
+            ( xs[i] >= 1.0f && std::memcmp( &output[i], &bOutput[i], sizeof( float ) ) != 0 ) )
+        {
+            saturated = false;
+        }
+    }
+
+    std::string name = std::string( "FadeSaturatedLanes/" ) + FastSIMD::GetFeatureSetString( level );
+
+    Check( saturated, name );
+    Check( BitExact( output, GenerateEachPosition2D( fade, xs, ys ) ), name + " (mixed lanes)" );
+}
+
+// Select with 0 falloff switches at the threshold, Condition equal to Threshold outputs A
+// With a falloff A and B are blended with Hermite easing within Threshold +/- Falloff and output exactly outside it
+static void TestSelectEdges( FastSIMD::FeatureSet level )
+{
+    std::string name = std::string( "SelectEdges/" ) + FastSIMD::GetFeatureSetString( level );
+
+    auto gradient = FastNoise::New<FastNoise::Gradient>( level );
+    gradient->SetMultiplier<FastNoise::Dim::X>( 1.0f );
+
+    auto a = FastNoise::New<FastNoise::Perlin>( level );
+    auto b = FastNoise::New<FastNoise::Simplex>( level );
+
+    auto select = FastNoise::New<FastNoise::Select>( level );
+    select->SetCondition( gradient );
+    select->SetA( a );
+    select->SetB( b );
+    select->SetThreshold( 0.25f );
+
+    std::vector<float> xs, ys;
+    GenerateBlendPositions( { -1.0f, 0.25f, std::nextafter( 0.25f, 1.0f ), 2.0f }, xs, ys );
+
+    std::vector<float> output = GeneratePositions2D( select, xs, ys );
+    std::vector<float> aOutput = GeneratePositions2D( a, xs, ys );
+    std::vector<float> bOutput = GeneratePositions2D( b, xs, ys );
+
+    bool hardSwitch = true;
+    for( size_t i = 0; i < xs.size(); i++ )
+    {
+        const float& expected = xs[i] <= 0.25f ? aOutput[i] : bOutput[i];
+
+        hardSwitch &= std::memcmp( &output[i], &expected, sizeof( float ) ) == 0;
+    }
+
+    Check( hardSwitch, name + " (hard switch)" );
+    Check( BitExact( output, GenerateEachPosition2D( select, xs, ys ) ), name + " (hard switch mixed lanes)" );
+
+    // Hermite( t ) at t = 0.25 and 0.75 is exact in float
+    auto constantA = FastNoise::New<FastNoise::Constant>( level );
+    constantA->SetValue( 0.0f );
+    auto constantB = FastNoise::New<FastNoise::Constant>( level );
+    constantB->SetValue( 1.0f );
+
+    select->SetA( constantA );
+    select->SetB( constantB );
+    select->SetThreshold( 0.0f );
+    select->SetFalloff( 0.5f );
+
+    GenerateBlendPositions( { -1.0f, -0.5f, -0.25f, 0.0f, 0.25f, 0.5f, 1.0f }, xs, ys );
+
+    std::vector<float> expected;
+    for( float x : xs )
+    {
+        expected.push_back( x <= -0.5f ? 0.0f : x >= 0.5f ? 1.0f : x == -0.25f ? 0.15625f : x == 0.0f ? 0.5f : 0.84375f );
+    }
+
+    output = GeneratePositions2D( select, xs, ys );
+
+    Check( MatchesAcrossFeatureSets( output, expected ), name + " (falloff)" );
+    Check( BitExact( output, GenerateEachPosition2D( select, xs, ys ) ), name + " (falloff mixed lanes)" );
+}
+
+// Switch splits Control Min to Control Max evenly between the sources, Control Max and values outside the
+// range clamp to the first or last source, NaN control uses Source 0
+static void TestSwitchEdges( FastSIMD::FeatureSet level )
+{
+    std::string name = std::string( "SwitchEdges/" ) + FastSIMD::GetFeatureSetString( level );
+
+    auto gradient = FastNoise::New<FastNoise::Gradient>( level );
+    gradient->SetMultiplier<FastNoise::Dim::X>( 1.0f );
+
+    auto source1 = FastNoise::New<FastNoise::Perlin>( level );
+
+    // Source 0, 2 and 3 keep their default values 0, 2 and 3
+    auto switchNode = FastNoise::New<FastNoise::Switch>( level );
+    switchNode->SetControl( gradient );
+    switchNode->SetControlMin( -1.0f );
+    switchNode->SetControlMax( 1.0f );
+    switchNode->SetSourceCount( 4 );
+    switchNode->SetSource( 1, source1 );
+
+    std::vector<float> branchX = { -2.0f, -1.0f, std::nextafter( -0.5f, -1.0f ), -0.5f, 0.0f, 0.5f, 0.999f, 1.0f, 5.0f };
+
+    // Relaxed FP builds assume no NaNs
+    if( kStrictFP )
+    {
+        branchX.push_back( std::numeric_limits<float>::quiet_NaN() );
+    }
+
+    std::vector<float> xs, ys;
+    GenerateBlendPositions( branchX, xs, ys );
+
+    std::vector<float> output = GeneratePositions2D( switchNode, xs, ys );
+    std::vector<float> source1Output = GeneratePositions2D( source1, xs, ys );
+
+    bool quantized = true;
+    for( size_t i = 0; i < xs.size(); i++ )
+    {
+        float x = xs[i];
+        int index = !( x >= -0.5f ) ? 0 : x < 0.0f ? 1 : x < 0.5f ? 2 : 3;
+        float expected = index == 1 ? source1Output[i] : (float)index;
+
+        quantized &= std::memcmp( &output[i], &expected, sizeof( float ) ) == 0;
+    }
+
+    Check( quantized, name );
+    Check( BitExact( output, GenerateEachPosition2D( switchNode, xs, ys ) ), name + " (mixed lanes)" );
+}
+
+static uint32_t ReadLittleEndian32( const std::vector<uint8_t>& buffer, size_t offset )
+{
+    return (uint32_t)buffer[offset] | ( (uint32_t)buffer[offset + 1] << 8 ) | ( (uint32_t)buffer[offset + 2] << 16 ) | ( (uint32_t)buffer[offset + 3] << 24 );
+}
+
+static size_t CountMembers( const FastNoise::NodeData* nodeData, std::unordered_set<const FastNoise::NodeData*>& visited )
+{
+    if( !visited.insert( nodeData ).second )
+    {
+        return 0;
+    }
+
+    size_t count = nodeData->variables.size() + nodeData->nodeLookups.size() + nodeData->hybrids.size();
+
+    for( const FastNoise::NodeData* source : nodeData->nodeLookups )
+    {
+        count += CountMembers( source, visited );
+    }
+    for( const auto& hybrid : nodeData->hybrids )
+    {
+        if( hybrid.first )
+        {
+            count += CountMembers( hybrid.first, visited );
+        }
+    }
+    return count;
+}
+
+// Demo node trees round tripped through the binary format generate the same output as the encoded string
+// The buffer is little endian on every host and stores every member, including defaults
+static void TestBinaryNodeTreeRoundTrip( FastSIMD::FeatureSet level )
+{
+    for( const auto& nodeTree : gDemoNodeTrees )
+    {
+        std::string name = std::string( "BinaryNodeTreeRoundTrip/" ) + nodeTree[0] + "/" + FastSIMD::GetFeatureSetString( level );
+
+        std::vector<std::unique_ptr<FastNoise::NodeData>> nodeDataOut;
+        FastNoise::NodeData* nodeData = FastNoise::Metadata::DeserialiseNodeData( nodeTree[1], nodeDataOut );
+
+        if( !nodeData )
+        {
+            Check( false, name + " (deserialise)" );
+            continue;
+        }
+
+        std::vector<uint8_t> binary = FastNoise::Metadata::SerialiseNodeDataBinary( nodeData );
+
+        std::unordered_set<const FastNoise::NodeData*> visited;
+        size_t memberCount = CountMembers( nodeData, visited );
+
+        Check( binary.size() >= 16 && std::memcmp( binary.data(), "FNBT", 4 ) == 0 && ReadLittleEndian32( binary, 8 ) == memberCount &&
+            ReadLittleEndian32( binary, 12 ) == binary.size(), name + " (layout)" );
+
+        FastNoise::SmartNode<> encoded = FastNoise::NewFromEncodedNodeTree( nodeTree[1], level );
+        FastNoise::SmartNode<> decoded = FastNoise::NewFromBinaryNodeTree( binary.data(), binary.size(), level );
+
+        Check( encoded && decoded && BitExact( GenerateGrids( encoded, 1337 ), GenerateGrids( decoded, 1337 ) ), name );
+    }
+}
+
+// Specialization profiles nodes at the region positions, nodes below a DomainScale see scaled positions in the tree
+// At the region positions the Fade input never reaches Fade Min, inside the tree it does, so the Fade must be kept
+static void TestSpecializeBelowDomainScale( FastSIMD::FeatureSet level )
+{
+    std::vector<std::unique_ptr<FastNoise::NodeData>> nodeData;
+
+    auto newNode = [&nodeData]( const FastNoise::Metadata& metadata )
+    {
+        nodeData.emplace_back( new FastNoise::NodeData( &metadata ) );
+        return nodeData.back().get();
+    };
+
+    FastNoise::NodeData* a = newNode( FastNoise::Metadata::Get<FastNoise::Constant>() );
+    a->variables[0] = 1.0f;
+
+    FastNoise::NodeData* b = newNode( FastNoise::Metadata::Get<FastNoise::Constant>() );
+    b->variables[0] = -1.0f;
+
+    FastNoise::NodeData* gradient = newNode( FastNoise::Metadata::Get<FastNoise::Gradient>() );
+    gradient->variables[0] = 1.0f; // X multiplier
+
+    FastNoise::NodeData* fade = newNode( FastNoise::Metadata::Get<FastNoise::Fade>() );
+    fade->nodeLookups[0] = a;
+    fade->nodeLookups[1] = b;
+    fade->hybrids[0].first = gradient;
+    fade->hybrids[1].second = 100.0f; // Fade Min, above every unscaled X in the region
+    fade->hybrids[2].second = 200.0f; // Fade Max
+
+    FastNoise::NodeData* scale = newNode( FastNoise::Metadata::Get<FastNoise::DomainScale>() );
+    scale->nodeLookups[0] = fade;
+    scale->variables[0] = 10.0f;
+
+    FastNoise::NodeDataProfileRegion region;
+    region.dimensions = 2;
+    region.count[0] = region.count[1] = 64;
+
+    std::string original = FastNoise::Metadata::SerialiseNodeData( scale );
+    std::string specialized = FastNoise::Metadata::SpecializeEncodedNodeTree( original.c_str(), { region } );
+
+    FastNoise::SmartNode<> originalNode = FastNoise::NewFromEncodedNodeTree( original.c_str(), level );
+    FastNoise::SmartNode<> specializedNode = FastNoise::NewFromEncodedNodeTree( specialized.c_str(), level );
+
+    std::string name = std::string( "SpecializeBelowDomainScale/" ) + FastSIMD::GetFeatureSetString( level );
+
+    if( !originalNode || !specializedNode )
+    {
+        Check( false, name );
+        return;
+    }
+
+    std::vector<float> originalNoise( 64 * 64 );
+    std::vector<float> specializedNoise( 64 * 64 );
+
+    originalNode->GenUniformGrid2D( originalNoise.data(), region.start[0], region.start[1], region.count[0], region.count[1], region.step[0], region.step[1], region.seed );
+    specializedNode->GenUniformGrid2D( specializedNoise.data(), region.start[0], region.start[1], region.count[0], region.count[1], region.step[0], region.step[1], region.seed );
+
+    Check( BitExact( originalNoise, specializedNoise ), name );
+}
+
+// Fractal Gain is evaluated at the fractal's own inputs, so it is profiled even though the fractal source is not
+// Gain is Min( X + 10, 0.75 ), constant over the region, and is replaced with a Constant
+static void TestSpecializeFractalGain( FastSIMD::FeatureSet level )
+{
+    std::vector<std::unique_ptr<FastNoise::NodeData>> nodeData;
+
+    auto newNode = [&nodeData]( const FastNoise::Metadata& metadata )
+    {
+        nodeData.emplace_back( new FastNoise::NodeData( &metadata ) );
+        return nodeData.back().get();
+    };
+
+    FastNoise::NodeData* gradient = newNode( FastNoise::Metadata::Get<FastNoise::Gradient>() );
+    gradient->variables[0] = 1.0f; // X multiplier
+    gradient->hybrids[0].second = 10.0f; // X offset
+
+    FastNoise::NodeData* gain = newNode( FastNoise::Metadata::Get<FastNoise::Min>() );
+    gain->nodeLookups[0] = gradient;
+    gain->hybrids[0].second = 0.75f;
+
+    FastNoise::NodeData* fractal = newNode( FastNoise::Metadata::Get<FastNoise::FractalFBm>() );
+    fractal->nodeLookups[0] = newNode( FastNoise::Metadata::Get<FastNoise::Perlin>() );
+    fractal->hybrids[0].first = gain;
+
+    FastNoise::NodeDataProfileRegion region;
+    region.dimensions = 2;
+    region.count[0] = region.count[1] = 64;
+
+    std::string original = FastNoise::Metadata::SerialiseNodeData( fractal );
+    std::string specialized = FastNoise::Metadata::SpecializeEncodedNodeTree( original.c_str(), { region } );
+
+    std::string name = std::string( "SpecializeFractalGain/" ) + FastSIMD::GetFeatureSetString( level );
+
+    std::vector<std::unique_ptr<FastNoise::NodeData>> specializedDataOut;
+    FastNoise::NodeData* specializedData = FastNoise::Metadata::DeserialiseNodeData( specialized.c_str(), specializedDataOut );
+
+    Check( specializedData && specializedData->hybrids.size() == 2 &&
+        ( specializedData->hybrids[0].first ? specializedData->hybrids[0].first->metadata == &FastNoise::Metadata::Get<FastNoise::Constant>() &&
+                                              specializedData->hybrids[0].first->variables[0].f == 0.75f
+                                            : specializedData->hybrids[0].second == 0.75f ), name + " (gain)" );
+
+    FastNoise::SmartNode<> originalNode = FastNoise::NewFromEncodedNodeTree( original.c_str(), level );
+    FastNoise::SmartNode<> specializedNode = FastNoise::NewFromEncodedNodeTree( specialized.c_str(), level );
+
+    if( !originalNode || !specializedNode )
+    {
+        Check( false, name );
+        return;
+    }
+
+    std::vector<float> originalNoise( 64 * 64 );
+    std::vector<float> specializedNoise( 64 * 64 );
+
+    originalNode->GenUniformGrid2D( originalNoise.data(), region.start[0], region.start[1], region.count[0], region.count[1], region.step[0], region.step[1], region.seed );
+    specializedNode->GenUniformGrid2D( specializedNoise.data(), region.start[0], region.start[1], region.count[0], region.count[1], region.step[0], region.step[1], region.seed );
+
+    Check( BitExact( originalNoise, specializedNoise ), name );
+}
+
+// Positions on multiples of 0.25, so merged power of two scales and small offsets don't round
+static std::vector<float> GenerateDyadicGrids( const FastNoise::SmartNode<>& node, int seed )
+{
+    std::vector<float> output;
+    std::vector<float> noise( 64 * 64 );
+
+    node->GenUniformGrid2D( noise.data(), -8.0f, -6.0f, 64, 64, 0.25f, 0.25f, seed );
+    output.insert( output.end(), noise.begin(), noise.end() );
+
+    node->GenUniformGrid3D( noise.data(), -2.0f, 1.0f, -3.0f, 16, 16, 16, 0.25f, 0.25f, 0.25f, seed );
+    output.insert( output.end(), noise.begin(), noise.begin() + 16 * 16 * 16 );
+
+    node->GenUniformGrid4D( noise.data(), -1.0f, 0.5f, 2.0f, -1.5f, 8, 8, 8, 8, 0.25f, 0.25f, 0.25f, 0.25f, seed );
+    output.insert( output.end(), noise.begin(), noise.begin() + 8 * 8 * 8 * 8 );
+
+    return output;
+}
+
+// Removing an add of 0 keeps -0 source outputs that the add turned into +0
+static bool BitExactIgnoringZeroSign( const std::vector<float>& a, const std::vector<float>& b )
+{
+    if( a.size() != b.size() )
+    {
+        return false;
+    }
+
+    for( size_t i = 0; i < a.size(); i++ )
+    {
+        if( std::memcmp( &a[i], &b[i], sizeof( float ) ) != 0 && !( a[i] == 0.0f && b[i] == 0.0f ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Each simplify rule family must leave the output unchanged, the trees only use values that the rewrites keep exact
+// Relaxed builds may still evaluate the original tree with approximate division, so they use the feature set tolerance
+static void TestSimplifyNodeData( FastSIMD::FeatureSet level )
+{
+    using Tree = std::vector<std::unique_ptr<FastNoise::NodeData>>;
+
+    auto newNode = []( Tree& tree, const FastNoise::Metadata& metadata )
+    {
+        return tree.emplace_back( new FastNoise::NodeData( &metadata ) ).get();
+    };
+
+    auto newSource = [newNode]( Tree& tree )
+    {
+        return newNode( tree, FastNoise::Metadata::Get<FastNoise::Simplex>() );
+    };
+
+    auto newConstant = [newNode]( Tree& tree, float value )
+    {
+        FastNoise::NodeData* constant = newNode( tree, FastNoise::Metadata::Get<FastNoise::Constant>() );
+        constant->variables[0] = value;
+        return constant;
+    };
+
+    // Operator with the LHS source and a constant RHS, or both constant when lhs is given
+    auto newOperator = [=]( Tree& tree, const FastNoise::Metadata& metadata, float rhs, const float* lhs = nullptr )
+    {
+        FastNoise::NodeData* op = newNode( tree, metadata );
+        FastNoise::NodeData* lhsNode = lhs ? newConstant( tree, *lhs ) : newSource( tree );
+
+        if( op->nodeLookups.empty() )
+        {
+            op->hybrids[0].first = lhsNode;
+            op->hybrids[1].second = rhs;
+        }
+        else
+        {
+            op->nodeLookups[0] = lhsNode;
+            op->hybrids[0].second = rhs;
+        }
+        return op;
+    };
+
+    auto newDomainScale = [=]( Tree& tree, float scale, FastNoise::NodeData* source )
+    {
+        FastNoise::NodeData* domainScale = newNode( tree, FastNoise::Metadata::Get<FastNoise::DomainScale>() );
+        domainScale->variables[0] = scale;
+        domainScale->nodeLookups[0] = source;
+        return domainScale;
+    };
+
+    auto newDomainOffset = [=]( Tree& tree, std::array<float, 4> offsets, FastNoise::NodeData* source )
+    {
+        FastNoise::NodeData* domainOffset = newNode( tree, FastNoise::Metadata::Get<FastNoise::DomainOffset>() );
+        for( size_t i = 0; i < offsets.size(); i++ )
+        {
+            domainOffset->hybrids[i].second = offsets[i];
+        }
+        domainOffset->nodeLookups[0] = source;
+        return domainOffset;
+    };
+
+    auto newSeedOffset = [=]( Tree& tree, int offset, FastNoise::NodeData* source )
+    {
+        FastNoise::NodeData* seedOffset = newNode( tree, FastNoise::Metadata::Get<FastNoise::SeedOffset>() );
+        seedOffset->variables[0] = offset;
+        seedOffset->nodeLookups[0] = source;
+        return seedOffset;
+    };
+
+    const float one = 1.0f, oneHalf = 1.5f, three = 3.0f;
+
+    struct Case
+    {
+        const char* name;
+        const char* change;
+        std::function<FastNoise::NodeData*( Tree& )> build;
+    };
+
+    const Case cases[] = {
+        // Identity and constant folds
+        { "AddZero", "removed add of 0", [=]( Tree& tree ) { return newOperator( tree, FastNoise::Metadata::Get<FastNoise::Add>(), 0.0f ); } },
+        { "SubtractZero", "removed subtract of 0", [=]( Tree& tree ) { return newOperator( tree, FastNoise::Metadata::Get<FastNoise::Subtract>(), 0.0f ); } },
+        { "MultiplyOne", "removed multiply by 1", [=]( Tree& tree ) { return newOperator( tree, FastNoise::Metadata::Get<FastNoise::Multiply>(), 1.0f ); } },
+        { "DivideOne", "removed divide by 1", [=]( Tree& tree ) { return newOperator( tree, FastNoise::Metadata::Get<FastNoise::Divide>(), 1.0f ); } },
+        { "DomainScaleOne", "removed scale of 1", [=]( Tree& tree ) { return newDomainScale( tree, 1.0f, newSource( tree ) ); } },
+        { "DomainOffsetZero", "removed offset of 0", [=]( Tree& tree ) { return newDomainOffset( tree, { 0.0f, 0.0f, 0.0f, 0.0f }, newSource( tree ) ); } },
+        { "SeedOffsetZero", "removed seed offset of 0", [=]( Tree& tree ) { return newSeedOffset( tree, 0, newSource( tree ) ); } },
+        { "FoldAdd", "folded constant operands", [=]( Tree& tree ) { return newOperator( tree, FastNoise::Metadata::Get<FastNoise::Add>(), 2.25f, &oneHalf ); } },
+        { "FoldSubtract", "folded constant operands", [=]( Tree& tree ) { return newOperator( tree, FastNoise::Metadata::Get<FastNoise::Subtract>(), 2.25f, &oneHalf ); } },
+        { "FoldMultiply", "folded constant operands", [=]( Tree& tree ) { return newOperator( tree, FastNoise::Metadata::Get<FastNoise::Multiply>(), -2.5f, &oneHalf ); } },
+        { "FoldDivide", "folded constant operands", [=]( Tree& tree ) { return newOperator( tree, FastNoise::Metadata::Get<FastNoise::Divide>(), 3.0f, &one ); } },
+        { "FoldMin", "folded constant operands", [=]( Tree& tree ) { return newOperator( tree, FastNoise::Metadata::Get<FastNoise::Min>(), -2.0f, &three ); } },
+        { "FoldMax", "folded constant operands", [=]( Tree& tree ) { return newOperator( tree, FastNoise::Metadata::Get<FastNoise::Max>(), -2.0f, &three ); } },
+
+        // Domain and seed merges
+        { "MergeDomainScale", "merged nested DomainScale", [=]( Tree& tree ) { return newDomainScale( tree, 2.0f, newDomainScale( tree, 4.0f, newSource( tree ) ) ); } },
+        { "MergeDomainScaleIntoAxisScale", "merged into nested DomainAxisScale", [=]( Tree& tree )
+        {
+            FastNoise::NodeData* axisScale = newNode( tree, FastNoise::Metadata::Get<FastNoise::DomainAxisScale>() );
+            axisScale->variables = { 2.0f, 0.5f, 4.0f, 0.25f };
+            axisScale->nodeLookups[0] = newSource( tree );
+            return newDomainScale( tree, 2.0f, axisScale );
+        } },
+        { "MergeDomainOffset", "merged nested DomainOffset", [=]( Tree& tree )
+        {
+            return newDomainOffset( tree, { 0.5f, 1.25f, -0.75f, 2.0f }, newDomainOffset( tree, { 1.0f, 0.25f, 0.5f, -1.5f }, newSource( tree ) ) );
+        } },
+        { "MergeSeedOffset", "merged nested SeedOffset", [=]( Tree& tree ) { return newSeedOffset( tree, 7, newSeedOffset( tree, -3, newSource( tree ) ) ); } },
+
+        // Constant inlining into hybrids
+        { "InlineOperatorConstant", "inlined Constant source into hybrid input", [=]( Tree& tree )
+        {
+            FastNoise::NodeData* add = newOperator( tree, FastNoise::Metadata::Get<FastNoise::Add>(), 0.0f );
+            add->hybrids[0].first = newConstant( tree, 0.75f );
+            return add;
+        } },
+        { "InlineDomainOffsetConstant", "inlined Constant source into hybrid input", [=]( Tree& tree )
+        {
+            FastNoise::NodeData* domainOffset = newDomainOffset( tree, { 0.5f, 0.0f, 0.25f, 0.0f }, newSource( tree ) );
+            domainOffset->hybrids[1].first = newConstant( tree, -1.25f );
+            return domainOffset;
+        } },
+    };
+
+    for( const Case& test : cases )
+    {
+        std::string name = std::string( "SimplifyNodeData/" ) + test.name + "/" + FastSIMD::GetFeatureSetString( level );
+
+        Tree tree;
+        FastNoise::NodeData* root = test.build( tree );
+        std::string original = FastNoise::Metadata::SerialiseNodeData( root );
+
+        std::vector<std::string> changes;
+        std::string simplified = FastNoise::Metadata::SerialiseNodeData( FastNoise::Metadata::SimplifyNodeData( root, tree, &changes ) );
+
+        bool applied = false;
+        for( const std::string& change : changes )
+        {
+            applied |= change.find( test.change ) != std::string::npos;
+        }
+
+        FastNoise::SmartNode<> originalNode = FastNoise::NewFromEncodedNodeTree( original.c_str(), level );
+        FastNoise::SmartNode<> simplifiedNode = FastNoise::NewFromEncodedNodeTree( simplified.c_str(), level );
+
+        if( !applied || !originalNode || !simplifiedNode )
+        {
+            Check( false, name + " (rule not applied)" );
+            continue;
+        }
+
+        std::vector<float> originalNoise = GenerateDyadicGrids( originalNode, 1337 );
+        std::vector<float> simplifiedNoise = GenerateDyadicGrids( simplifiedNode, 1337 );
+
+        if( !kStrictFP )
+        {
+            Check( MatchesAcrossFeatureSets( originalNoise, simplifiedNoise ), name );
+        }
+        else if( std::strcmp( test.name, "AddZero" ) == 0 )
+        {
+            Check( BitExactIgnoringZeroSign( originalNoise, simplifiedNoise ), name );
+        }
+        else
+        {
+            Check( BitExact( originalNoise, simplifiedNoise ), name );
+        }
+    }
+}
+
+// Trees in an arena must generate the same output as trees in the regular pools, including trees larger than one arena slab
+// Releasing the trees releases their arenas
+static void TestArenaNodeTrees( FastSIMD::FeatureSet level )
+{
+    std::string suffix = std::string( "/" ) + FastSIMD::GetFeatureSetString( level );
+    FastNoise::SmartNodeMemoryStats baseline = FastNoise::SmartNodeManager::GetMemoryStats();
+
+    for( const auto& nodeTree : gDemoNodeTrees )
+    {
+        FastNoise::SmartNode<> arena = FastNoise::NewFromEncodedNodeTreeInArena( nodeTree[1], level );
+        FastNoise::SmartNode<> regular = FastNoise::NewFromEncodedNodeTree( nodeTree[1], level );
+
+        Check( arena && regular && BitExact( GenerateGrids( arena, 1337 ), GenerateGrids( regular, 1337 ) ), std::string( "ArenaNodeTrees/" ) + nodeTree[0] + suffix );
+    }
+
+    // Chain of Add nodes adding 1 each
+    const int chainLength = 1000;
+    std::vector<std::unique_ptr<FastNoise::NodeData>> nodeData;
+
+    FastNoise::NodeData* chain = nodeData.emplace_back( new FastNoise::NodeData( &FastNoise::Metadata::Get<FastNoise::Constant>() ) ).get();
+    chain->variables[0] = 0.0f;
+
+    for( int i = 0; i < chainLength; i++ )
+    {
+        FastNoise::NodeData* add = nodeData.emplace_back( new FastNoise::NodeData( &FastNoise::Metadata::Get<FastNoise::Add>() ) ).get();
+        add->nodeLookups[0] = chain;
+        add->hybrids[0].second = 1.0f;
+        chain = add;
+    }
+
+    FastNoise::SmartNode<> tree = FastNoise::Metadata::CreateNodeTreeInArena( chain, level );
+    Check( tree && tree->GenSingle2D( 0.5f, 0.5f, 1337 ) == (float)chainLength, "ArenaNodeTrees/AddChain" + suffix );
+    tree = nullptr;
+
+    FastNoise::SmartNodeMemoryStats stats = FastNoise::SmartNodeManager::GetMemoryStats();
+    Check( stats.liveAllocations == baseline.liveAllocations && stats.liveBytes == baseline.liveBytes, "ArenaNodeTrees/Released" + suffix );
+}
+
+// Encoded Constant node trees with distinct values
+static std::vector<std::string> EncodeConstants( int count )
+{
+    std::vector<std::string> encoded;
+
+    for( int i = 0; i < count; i++ )
+    {
+        FastNoise::NodeData constant( &FastNoise::Metadata::Get<FastNoise::Constant>() );
+        constant.variables[0] = (float)i;
+        encoded.push_back( FastNoise::Metadata::SerialiseNodeData( &constant ) );
+    }
+    return encoded;
+}
+
+// Hits return the same tree, the least recently used tree is evicted and concurrent lookups share one tree per key
+static void TestEncodedNodeTreeCache()
+{
+    size_t defaultCapacity = FastNoise::GetEncodedNodeTreeCacheStats().capacity;
+    std::vector<std::string> encoded = EncodeConstants( 8 );
+
+    FastNoise::ClearEncodedNodeTreeCache();
+    FastNoise::SetEncodedNodeTreeCacheCapacity( 2 );
+
+    auto get = [&encoded]( int i ) { return FastNoise::NewFromEncodedNodeTreeCached( encoded[i].c_str() ); };
+
+    FastNoise::SmartNode<const FastNoise::Generator> tree0 = get( 0 );
+    FastNoise::SmartNode<const FastNoise::Generator> tree1 = get( 1 );
+    FastNoise::EncodedNodeTreeCacheStats stats = FastNoise::GetEncodedNodeTreeCacheStats();
+
+    Check( tree0 && tree1 && get( 0 ) == tree0 && stats.misses == 2 && FastNoise::GetEncodedNodeTreeCacheStats().hits == 1, "EncodedNodeTreeCache/Hit" );
+
+    // 0 was used more recently than 1, so 1 is evicted
+    get( 2 );
+    stats = FastNoise::GetEncodedNodeTreeCacheStats();
+    bool evictedLru = stats.evictions == 1 && stats.size == 2 && get( 0 ) == tree0;
+    evictedLru &= get( 1 ) != tree1 && FastNoise::GetEncodedNodeTreeCacheStats().misses == 4;
+
+    Check( evictedLru, "EncodedNodeTreeCache/EvictLeastRecentlyUsed" );
+
+    // Evicted trees stay valid while referenced
+    Check( tree1->GenSingle2D( 0, 0, 1337 ) == 1.0f, "EncodedNodeTreeCache/EvictedTreeAlive" );
+
+    FastNoise::ClearEncodedNodeTreeCache();
+    FastNoise::SetEncodedNodeTreeCacheCapacity( encoded.size() );
+
+    const int threadCount = 8;
+    const int lookups = 1000;
+    std::vector<std::vector<const FastNoise::Generator*>> results( threadCount );
+    std::vector<std::thread> threads;
+
+    for( int t = 0; t < threadCount; t++ )
+    {
+        threads.emplace_back( [&, t]
+        {
+            for( int i = 0; i < lookups; i++ )
+            {
+                results[t].push_back( get( ( i + t ) % (int)encoded.size() ).get() );
+            }
+        } );
+    }
+
+    for( std::thread& thread : threads )
+    {
+        thread.join();
+    }
+
+    bool shared = true;
+    for( int t = 0; t < threadCount; t++ )
+    {
+        for( int i = 0; i < lookups; i++ )
+        {
+            const FastNoise::Generator* tree = results[t][i];
+            int key = ( i + t ) % (int)encoded.size();
+
+            shared &= tree && tree == get( key ).get() && tree->GenSingle2D( 0, 0, 1337 ) == (float)key;
+        }
+    }
+
+    stats = FastNoise::GetEncodedNodeTreeCacheStats();
+    Check( shared && stats.size == encoded.size() && stats.evictions == 0 && stats.hits + stats.misses == (size_t)threadCount * lookups * 2,
+        "EncodedNodeTreeCache/Concurrent" );
+
+    FastNoise::ClearEncodedNodeTreeCache();
+    FastNoise::SetEncodedNodeTreeCacheCapacity( defaultCapacity );
+}
+
+// Nodes are created and released concurrently on many threads, including releases on a thread other than the creator
+// Once every thread has exited its cached blocks are flushed, so the allocator counters return to where they started
+static void TestNodeAllocatorThreads()
+{
+    const int threadCount = 8;
+    const int iterations = 4000;
+    const size_t heldPerThread = 32;
+
+    using NodeFactory = std::function<FastNoise::SmartNode<>()>;
+
+    const NodeFactory factories[] = {
+        [] { return FastNoise::New<FastNoise::Perlin>(); },
+        [] { return FastNoise::New<FastNoise::FractalFBm>(); },
+        [] { return FastNoise::New<FastNoise::DomainWarpGradient>(); },
+        [] { return FastNoise::New<FastNoise::CellularDistance>(); },
+    };
+
+    FastNoise::SmartNodeMemoryStats baseline = FastNoise::SmartNodeManager::GetMemoryStats();
+
+    std::vector<std::vector<FastNoise::SmartNode<FastNoise::Constant>>> held( threadCount );
+    std::vector<std::thread> threads;
+
+    for( int t = 0; t < threadCount; t++ )
+    {
+        threads.emplace_back( [&, t]
+        {
+            std::vector<FastNoise::SmartNode<>> churn( 16 );
+
+            for( int i = 0; i < iterations; i++ )
+            {
+                churn[i % churn.size()] = factories[( i + t ) % std::size( factories )]();
+
+                auto constant = FastNoise::New<FastNoise::Constant>();
+                constant->SetValue( (float)( t * iterations + i ) );
+
+                if( held[t].size() < heldPerThread )
+                {
+                    held[t].push_back( constant );
+                }
+                else
+                {
+                    held[t][i % heldPerThread] = constant;
+                }
+            }
+        } );
+    }
+
+    for( std::thread& thread : threads )
+    {
+        thread.join();
+    }
+
+    FastNoise::SmartNodeMemoryStats stats = FastNoise::SmartNodeManager::GetMemoryStats();
+    bool intact = stats.liveAllocations == baseline.liveAllocations + threadCount * heldPerThread;
+
+    // Overlapping blocks would have overwritten values
+    for( int t = 0; t < threadCount; t++ )
+    {
+        for( size_t j = 0; j < heldPerThread; j++ )
+        {
+            int i = iterations - (int)heldPerThread + (int)j;
+            intact &= held[t][i % heldPerThread]->GenSingle2D( 0, 0, 1337 ) == (float)( t * iterations + i );
+        }
+    }
+
+    Check( intact, "NodeAllocatorThreads/Held" );
+
+    // Release every thread's nodes from a different thread
+    threads.clear();
+    for( int t = 0; t < threadCount; t++ )
+    {
+        threads.emplace_back( [&held, t] { held[( t + 1 ) % threadCount].clear(); } );
+    }
+
+    for( std::thread& thread : threads )
+    {
+        thread.join();
+    }
+
+    stats = FastNoise::SmartNodeManager::GetMemoryStats();
+    Check( stats.liveAllocations == baseline.liveAllocations && stats.liveBytes == baseline.liveBytes && stats.threadCachedBytes == baseline.threadCachedBytes,
+        "NodeAllocatorThreads/Released" );
+}
+
+// A tree containing a dependency loop is never structurally equal, even to itself
+static void TestStructuralEqualityLoops()
+{
+    FastNoise::NodeData leaf( &FastNoise::Metadata::Get<FastNoise::Constant>() );
+    FastNoise::NodeData add( &FastNoise::Metadata::Get<FastNoise::Add>() );
+    FastNoise::NodeData loop( &FastNoise::Metadata::Get<FastNoise::Add>() );
+    FastNoise::NodeData root( &FastNoise::Metadata::Get<FastNoise::Multiply>() );
+
+    add.nodeLookups[0] = &leaf;
+    loop.nodeLookups[0] = &loop;
+    root.nodeLookups[0] = &loop;
+
+    Check( FastNoise::Metadata::NodeDataStructurallyEqual( &add, &add ), "StructuralEquality/Identical" );
+    Check( !FastNoise::Metadata::NodeDataStructurallyEqual( &loop, &loop ), "StructuralEquality/LoopIdentical" );
+    Check( !FastNoise::Metadata::NodeDataStructurallyEqual( &root, &root ), "StructuralEquality/LoopBelowRoot" );
+}
+
+// Batch jobs must match generating each job on its own, on the internal pool, through a caller task system and on a recreated pool
+static void TestUniformGridBatch()
+{
+    void* node = fnNewFromEncodedNodeTree( gDemoNodeTrees[0][1], ~0u );
+
+    if( !node )
+    {
+        Check( false, "UniformGridBatch (node)" );
+        return;
+    }
+
+    const int jobCount = 24;
+    std::vector<fnUniformGridJob> jobs( jobCount );
+    std::vector<std::vector<float>> reference( jobCount );
+    std::vector<std::vector<float>> output( jobCount );
+    std::vector<std::array<float, 2>> referenceMinMax( jobCount );
+
+    for( int i = 0; i < jobCount; i++ )
+    {
+        fnUniformGridJob& job = jobs[i];
+        job = {};
+        job.node = node;
+        job.dimensions = 2 + i % 3;
+        job.seed = 1337 + i;
+
+        for( int d = 0; d < 4; d++ )
+        {
+            job.offset[d] = -20.0f + 3.7f * (float)( i + d );
+            job.count[d] = job.dimensions == 2 ? 32 : job.dimensions == 3 ? 12 : 6;
+            job.stepSize[d] = 0.9f + 0.1f * (float)d;
+        }
+
+        size_t size = 1;
+        for( int d = 0; d < job.dimensions; d++ )
+        {
+            size *= (size_t)job.count[d];
+        }
+
+        reference[i].resize( size );
+        output[i].resize( size );
+        job.noiseOut = output[i].data();
+
+        float* noise = reference[i].data();
+        float* minMax = referenceMinMax[i].data();
+
+        switch( job.dimensions )
+        {
+        case 2:
+            fnGenUniformGrid2D( node, noise, job.offset[0], job.offset[1], job.count[0], job.count[1], job.stepSize[0], job.stepSize[1], job.seed, minMax );
+            break;
+        case 3:
+            fnGenUniformGrid3D( node, noise, job.offset[0], job.offset[1], job.offset[2], job.count[0], job.count[1], job.count[2],
+                job.stepSize[0], job.stepSize[1], job.stepSize[2], job.seed, minMax );
+            break;
+        default:
+            fnGenUniformGrid4D( node, noise, job.offset[0], job.offset[1], job.offset[2], job.offset[3], job.count[0], job.count[1], job.count[2], job.count[3],
+                job.stepSize[0], job.stepSize[1], job.stepSize[2], job.stepSize[3], job.seed, minMax );
+            break;
+        }
+    }
+
+    auto matches = [&]
+    {
+        bool match = true;
+        for( int i = 0; i < jobCount; i++ )
+        {
+            match &= BitExact( reference[i], output[i] ) &&
+                jobs[i].outputMinMax[0] == referenceMinMax[i][0] && jobs[i].outputMinMax[1] == referenceMinMax[i][1];
+
+            std::fill( output[i].begin(), output[i].end(), 0.0f );
+            jobs[i].outputMinMax[0] = jobs[i].outputMinMax[1] = 0.0f;
+        }
+        return match;
+    };
+
+    Check( fnGenUniformGridBatch( jobs.data(), jobCount, 0 ) && matches(), "UniformGridBatch/Pool" );
+    Check( fnGenUniformGridBatch( jobs.data(), jobCount, 2 ) && matches(), "UniformGridBatch/PoolMaxThreads" );
+
+    // Caller task system running the tasks on its own threads
+    struct TaskSystem
+    {
+        int threadCount;
+        int submits;
+    };
+
+    fnBatchSubmitFunc submit = []( void* userData, fnBatchTaskFunc task, void* taskData, int taskCount )
+    {
+        TaskSystem& taskSystem = *static_cast<TaskSystem*>( userData );
+        std::vector<std::thread> threads;
+
+        taskSystem.submits++;
+
+        for( int t = 0; t < taskSystem.threadCount; t++ )
+        {
+            threads.emplace_back( [=, &taskSystem]
+            {
+                for( int i = t; i < taskCount; i += taskSystem.threadCount )
+                {
+                    task( taskData, i );
+                }
+            } );
+        }
+
+        for( std::thread& thread : threads )
+        {
+            thread.join();
+        }
+    };
+
+    TaskSystem taskSystem = { 3, 0 };
+    Check( fnGenUniformGridBatchSubmit( jobs.data(), jobCount, submit, &taskSystem ) && taskSystem.submits == 1 && matches(), "UniformGridBatch/Submit" );
+    Check( !fnGenUniformGridBatchSubmit( jobs.data(), jobCount, nullptr, nullptr ), "UniformGridBatch/SubmitNull" );
+
+    // A batch after shutdown creates a new pool
+    fnShutdownBatchPool();
+    Check( fnGenUniformGridBatch( jobs.data(), jobCount, 0 ) && matches(), "UniformGridBatch/RecreatedPool" );
+    fnShutdownBatchPool();
+
+    // Invalid jobs are rejected before anything runs
+    jobs[jobCount - 1].node = nullptr;
+    output[0][0] = 1234.0f;
+    Check( !fnGenUniformGridBatch( jobs.data(), jobCount, 0 ) && output[0][0] == 1234.0f, "UniformGridBatch/InvalidJob" );
+
+    fnDeleteNodeRef( node );
+}
+
+int main()
+{
+    std::vector<FastSIMD::FeatureSet> levels;
+
+    for( auto level : FastSIMD::FastSIMD_FastNoise::CompiledFeatureSets::AsArray )
+    {
+        FastNoise::SmartNode<> probe = FastNoise::New<FastNoise::Constant>( level );
+
+        if( probe && probe->GetActiveFeatureSet() == level )
+        {
+            levels.push_back( level );
+        }
+    }
+
+    for( FastSIMD::FeatureSet level : levels )
+    {
+        TestDomainWarpInlineSource( level );
+        TestFadeSaturatedLanes( level );
+        TestSelectEdges( level );
+        TestSwitchEdges( level );
+        TestBinaryNodeTreeRoundTrip( level );
+        TestSpecializeBelowDomainScale( level );
+        TestSpecializeFractalGain( level );
+        TestArenaNodeTrees( level );
+        TestSimplifyNodeData( level );
+    }
+
+    if( !levels.empty() )
+    {
+        TestSimplex4DGradients( levels );
+    }
+
+    TestStructuralEqualityLoops();
+    TestEncodedNodeTreeCache();
+    TestNodeAllocatorThreads();
+    TestUniformGridBatch();
+
+    std::cout << ( gFailures ? "FAILED: " : "All checks passed" );
+    if( gFailures )
+    {
+        std::cout << gFailures << " checks";
+    }
+    std::cout << std::endl;
+
+    return gFailures ? 1 : 0;
+}
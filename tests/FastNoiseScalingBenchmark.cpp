@@ -0,0 +1,522 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "FastNoise/FastNoise.h"
+#include "FastSIMD/FastSIMD_FastNoise_config.h"
+
+#include "WorkloadTrees.h"
+
+// Measures how generation throughput scales with thread count
+// N threads generate independent 3D chunks, either from one shared node tree or from a per-thread copy of the tree
+// On Linux threads can be pinned to cores or NUMA nodes using the topology from sysfs
+//
+// Options:
+//   --threads=1,2,4        Thread counts to run, defaults to powers of 2 up to the hardware thread count
+//   --placement=spread,... none: no pinning, spread: physical cores first across NUMA nodes then SMT siblings,
+//                          compact: fill SMT siblings and NUMA nodes in order, numa: pin to all cores of a NUMA node
+//   --mode=shared,copy     Share one node tree between threads or create a copy per thread
+//   --tree=<text>          Only run trees with names containing text
+//   --feature-set=<name>   Max SIMD feature set, e.g. to compare AVX2 and AVX512 frequency behaviour
+//   --chunk=32             Chunk size along each axis
+//   --seconds=1            Measurement time per run
+//   --csv                  Output CSV instead of a table
+
+struct CpuInfo
+{
+    int cpu;
+    int package = 0;
+    int core;
+    int numaNode = 0;
+    int smtIndex = 0; // Index among the hardware threads of the same physical core
+};
+
+enum class Placement
+{
+    None,
+    Spread,
+    Compact,
+    Numa
+};
+
+static const char* kPlacementStrings[] = { "none", "spread", "compact", "numa" };
+
+struct Options
+{
+    std::vector<int> threadCounts;
+    std::vector<Placement> placements;
+    std::vector<bool> sharedModes = { true, false };
+    std::string treeFilter;
+    FastSIMD::FeatureSet featureSet = FastSIMD::FeatureSet::Max;
+    int chunkSize = 32;
+    double seconds = 1.0;
+    bool csv = false;
+};
+
+static std::vector<int> ParseList( const std::string& list )
+{
+    // Handles both "1,2,4" and sysfs cpu lists "0-3,8-11"
+    std::vector<int> values;
+    size_t pos = 0;
+
+    while( pos < list.size() )
+    {
+        size_t end = list.find( ',', pos );
+        if( end == std::string::npos )
+        {
+            end = list.size();
+        }
+
+        std::string item = list.substr( pos, end - pos );
+        size_t dash = item.find( '-' );
+
+        if( !item.empty() )
+        {
+            if( dash != std::string::npos )
+            {
+                for( int i = std::stoi( item.substr( 0, dash ) ); i <= std::stoi( item.substr( dash + 1 ) ); i++ )
+                {
+                    values.push_back( i );
+                }
+            }
+            else
+            {
+                values.push_back( std::stoi( item ) );
+            }
+        }
+        pos = end + 1;
+    }
+    return values;
+}
+
+static std::string ReadFirstLine( const std::string& path )
+{
+    std::ifstream file( path );
+    std::string line;
+    std::getline( file, line );
+    return line;
+}
+
+static std::vector<CpuInfo> DetectCpus()
+{
+    std::vector<CpuInfo> cpus;
+
+#ifdef __linux__
+    for( int cpu : ParseList( ReadFirstLine( "/sys/devices/system/cpu/online" ) ) )
+    {
+        std::string topology = "/sys/devices/system/cpu/cpu" + std::to_string( cpu ) + "/topology/";
+        std::string package = ReadFirstLine( topology + "physical_package_id" );
+        std::string core = ReadFirstLine( topology + "core_id" );
+
+        CpuInfo info;
+        info.cpu = cpu;
+        info.package = package.empty() ? 0 : std::stoi( package );
+        info.core = core.empty() ? cpu : std::stoi( core );
+        cpus.push_back( info );
+    }
+
+    for( int node : ParseList( ReadFirstLine( "/sys/devices/system/node/online" ) ) )
+    {
+        for( int cpu : ParseList( ReadFirstLine( "/sys/devices/system/node/node" + std::to_string( node ) + "/cpulist" ) ) )
+        {
+            for( CpuInfo& info : cpus )
+            {
+                if( info.cpu == cpu )
+                {
+                    info.numaNode = node;
+                }
+            }
+        }
+    }
+
+    std::map<std::pair<int, int>, int> coreThreadCount;
+    for( CpuInfo& info : cpus )
+    {
+        info.smtIndex = coreThreadCount[{ info.package, info.core }]++;
+    }
+#endif
+
+    if( cpus.empty() )
+    {
+        for( int cpu = 0; cpu < (int)std::max( std::thread::hardware_concurrency(), 1u ); cpu++ )
+        {
+            CpuInfo info;
+            info.cpu = info.core = cpu;
+            cpus.push_back( info );
+        }
+    }
+    return cpus;
+}
+
+static int CountNumaNodes( const std::vector<CpuInfo>& cpus )
+{
+    int maxNode = 0;
+    for( const CpuInfo& info : cpus )
+    {
+        maxNode = std::max( maxNode, info.numaNode );
+    }
+    return maxNode + 1;
+}
+
+// Returns the set of cpus each thread is pinned to, empty for no pinning
+static std::vector<std::vector<int>> AssignCpus( const std::vector<CpuInfo>& cpus, Placement placement, int threadCount )
+{
+    std::vector<std::vector<int>> assignment( threadCount );
+    std::vector<CpuInfo> order = cpus;
+
+    switch( placement )
+    {
+    case Placement::None:
+        return assignment;
+
+    case Placement::Spread:
+    {
+        // Round robin across NUMA nodes, using every physical core before any SMT siblings
+        std::map<std::pair<int, int>, int> indexInNode;
+        std::vector<std::tuple<int, int, int, int>> keys;
+
+        std::sort( order.begin(), order.end(), []( const CpuInfo& a, const CpuInfo& b ) { return a.cpu < b.cpu; } );
+        for( const CpuInfo& info : order )
+        {
+            keys.emplace_back( info.smtIndex, indexInNode[{ info.smtIndex, info.numaNode }]++, info.numaNode, info.cpu );
+        }
+        std::sort( keys.begin(), keys.end() );
+
+        for( int i = 0; i < threadCount; i++ )
+        {
+            assignment[i].push_back( std::get<3>( keys[i % keys.size()] ) );
+        }
+        return assignment;
+    }
+
+    case Placement::Compact:
+        std::sort( order.begin(), order.end(), []( const CpuInfo& a, const CpuInfo& b )
+        {
+            return std::tie( a.numaNode, a.package, a.core, a.smtIndex ) < std::tie( b.numaNode, b.package, b.core, b.smtIndex );
+        } );
+
+        for( int i = 0; i < threadCount; i++ )
+        {
+            assignment[i].push_back( order[i % order.size()].cpu );
+        }
+        return assignment;
+
+    case Placement::Numa:
+    {
+        int nodeCount = CountNumaNodes( cpus );
+
+        for( int i = 0; i < threadCount; i++ )
+        {
+            for( const CpuInfo& info : cpus )
+            {
+                if( info.numaNode == i % nodeCount )
+                {
+                    assignment[i].push_back( info.cpu );
+                }
+            }
+        }
+        return assignment;
+    }
+    }
+    return assignment;
+}
+
+static bool PinCurrentThread( const std::vector<int>& cpus )
+{
+    if( cpus.empty() )
+    {
+        return true;
+    }
+
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    for( int cpu : cpus )
+    {
+        CPU_SET( cpu, &set );
+    }
+    return pthread_setaffinity_np( pthread_self(), sizeof( set ), &set ) == 0;
+#else
+    return false;
+#endif
+}
+
+struct RunResult
+{
+    double samplesPerSecond = 0;
+    bool pinned = true;
+};
+
+static RunResult RunScaling( const WorkloadTree& tree, const Options& options, bool shared, const std::vector<std::vector<int>>& threadCpus )
+{
+    int threadCount = (int)threadCpus.size();
+    int chunk = options.chunkSize;
+    size_t chunkSamples = (size_t)chunk * chunk * chunk;
+
+    FastNoise::SmartNode<> sharedTree = shared ? tree.create( options.featureSet ) : FastNoise::SmartNode<>();
+
+    std::atomic<int> readyCount = 0;
+    std::atomic<bool> start = false;
+    std::atomic<bool> stop = false;
+    std::atomic<bool> pinned = true;
+    std::vector<double> threadRates( threadCount );
+    std::vector<std::thread> threads;
+
+    for( int threadIdx = 0; threadIdx < threadCount; threadIdx++ )
+    {
+        threads.emplace_back( [&, threadIdx]
+        {
+            using Clock = std::chrono::steady_clock;
+
+            if( !PinCurrentThread( threadCpus[threadIdx] ) )
+            {
+                pinned = false;
+            }
+
+            // Per thread copies are created after pinning, node memory still comes from the shared node pools so it is not NUMA local
+            FastNoise::SmartNode<> generator = shared ? sharedTree : tree.create( options.featureSet );
+            std::vector<float> data( chunkSamples );
+            int chunkIdx = threadIdx * 100000;
+
+            auto generateChunk = [&]
+            {
+                generator->GenUniformGrid3D( data.data(), (float)( chunkIdx++ * chunk ), 0, 0, chunk, chunk, chunk, 1.0f, 1.0f, 1.0f, 1337 );
+            };
+
+            if( generator )
+            {
+                generateChunk(); // Warm up
+            }
+
+            readyCount++;
+            while( !start.load() )
+            {
+                std::this_thread::yield();
+            }
+
+            size_t chunkCount = 0;
+            Clock::time_point startTime = Clock::now();
+            Clock::time_point endTime = startTime;
+
+            while( generator && !stop.load( std::memory_order_relaxed ) )
+            {
+                generateChunk();
+                chunkCount++;
+                endTime = Clock::now();
+            }
+
+            double seconds = std::chrono::duration<double>( endTime - startTime ).count();
+            threadRates[threadIdx] = seconds > 0 ? (double)( chunkCount * chunkSamples ) / seconds : 0;
+        } );
+    }
+
+    while( readyCount.load() < threadCount )
+    {
+        std::this_thread::yield();
+    }
+
+    start = true;
+    std::this_thread::sleep_for( std::chrono::duration<double>( options.seconds ) );
+    stop = true;
+
+    for( std::thread& thread : threads )
+    {
+        thread.join();
+    }
+
+    RunResult result;
+    result.pinned = pinned;
+    for( double rate : threadRates )
+    {
+        result.samplesPerSecond += rate;
+    }
+    return result;
+}
+
+static bool ParseOptions( int argc, char** argv, Options& options )
+{
+    for( int i = 1; i < argc; i++ )
+    {
+        std::string arg = argv[i];
+        size_t equals = arg.find( '=' );
+        std::string key = arg.substr( 0, equals );
+        std::string value = equals == std::string::npos ? "" : arg.substr( equals + 1 );
+
+        if( key == "--threads" )
+        {
+            options.threadCounts = ParseList( value );
+        }
+        else if( key == "--placement" )
+        {
+            options.placements.clear();
+            for( size_t pos = 0; pos <= value.size(); )
+            {
+                size_t end = std::min( value.find( ',', pos ), value.size() );
+                std::string name = value.substr( pos, end - pos );
+                auto found = std::find_if( std::begin( kPlacementStrings ), std::end( kPlacementStrings ), [&]( const char* s ) { return name == s; } );
+
+                if( found == std::end( kPlacementStrings ) )
+                {
+                    std::cerr << "Unknown placement: " << name << std::endl;
+                    return false;
+                }
+                options.placements.push_back( (Placement)( found - std::begin( kPlacementStrings ) ) );
+                pos = end + 1;
+            }
+        }
+        else if( key == "--mode" )
+        {
+            options.sharedModes.clear();
+            if( value.find( "shared" ) != std::string::npos ) options.sharedModes.push_back( true );
+            if( value.find( "copy" ) != std::string::npos ) options.sharedModes.push_back( false );
+        }
+        else if( key == "--tree" )
+        {
+            options.treeFilter = value;
+        }
+        else if( key == "--feature-set" )
+        {
+            bool found = false;
+            for( auto level : FastSIMD::FastSIMD_FastNoise::CompiledFeatureSets::AsArray )
+            {
+                if( value == FastSIMD::GetFeatureSetString( level ) )
+                {
+                    options.featureSet = level;
+                    found = true;
+                }
+            }
+
+            if( !found )
+            {
+                std::cerr << "Feature set not compiled: " << value << std::endl;
+                return false;
+            }
+        }
+        else if( key == "--chunk" )
+        {
+            options.chunkSize = std::max( std::stoi( value ), 1 );
+        }
+        else if( key == "--seconds" )
+        {
+            options.seconds = std::stod( value );
+        }
+        else if( key == "--csv" )
+        {
+            options.csv = true;
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main( int argc, char** argv )
+{
+    std::vector<CpuInfo> cpus = DetectCpus();
+    int hardwareThreads = (int)cpus.size();
+    int numaNodes = CountNumaNodes( cpus );
+    int physicalCores = (int)std::count_if( cpus.begin(), cpus.end(), []( const CpuInfo& info ) { return info.smtIndex == 0; } );
+
+    Options options;
+
+    for( int threads = 1; threads < hardwareThreads; threads *= 2 )
+    {
+        options.threadCounts.push_back( threads );
+    }
+    options.threadCounts.push_back( hardwareThreads );
+
+#ifdef __linux__
+    options.placements = { Placement::Spread, Placement::Compact };
+    if( numaNodes > 1 )
+    {
+        options.placements.push_back( Placement::Numa );
+    }
+#else
+    options.placements = { Placement::None };
+#endif
+
+    if( !ParseOptions( argc, argv, options ) )
+    {
+        return 1;
+    }
+
+    std::vector<WorkloadTree> trees = BuildWorkloadTrees();
+
+    if( !options.csv )
+    {
+        std::cout << "Hardware threads: " << hardwareThreads << ", physical cores: " << physicalCores << ", NUMA nodes: " << numaNodes << "\n";
+        std::cout << "Chunk: " << options.chunkSize << "^3, " << options.seconds << "s per run\n\n";
+        std::printf( "%-24s %-8s %-7s %-9s %7s %14s %18s %10s\n", "Tree", "SIMD", "Mode", "Placement", "Threads", "Msamples/s", "Msamples/s/thread", "Efficiency" );
+    }
+    else
+    {
+        std::cout << "tree,simd,mode,placement,threads,samples_per_second,samples_per_second_per_thread,efficiency\n";
+    }
+
+    for( const WorkloadTree& tree : trees )
+    {
+        if( tree.name.find( options.treeFilter ) == std::string::npos )
+        {
+            continue;
+        }
+
+        FastNoise::SmartNode<> probe = tree.create( options.featureSet );
+        if( !probe )
+        {
+            std::cerr << "Could not create node tree: " << tree.name << std::endl;
+            continue;
+        }
+        const char* simd = FastSIMD::GetFeatureSetString( probe->GetActiveFeatureSet() );
+
+        for( bool shared : options.sharedModes )
+        {
+            for( Placement placement : options.placements )
+            {
+                // Efficiency is relative to a single pinned thread with the same mode and placement
+                double singleThreadRate = RunScaling( tree, options, shared, AssignCpus( cpus, placement, 1 ) ).samplesPerSecond;
+
+                for( int threadCount : options.threadCounts )
+                {
+                    RunResult result = threadCount == 1 && singleThreadRate > 0 ?
+                        RunResult{ singleThreadRate, true } :
+                        RunScaling( tree, options, shared, AssignCpus( cpus, placement, threadCount ) );
+
+                    double perThread = result.samplesPerSecond / threadCount;
+                    double efficiency = singleThreadRate > 0 ? perThread / singleThreadRate : 0;
+                    const char* mode = shared ? "shared" : "copy";
+                    const char* placementName = kPlacementStrings[(int)placement];
+
+                    if( options.csv )
+                    {
+                        std::printf( "\"%s\",%s,%s,%s,%d,%.0f,%.0f,%.4f\n", tree.name.c_str(), simd, mode, placementName, threadCount, result.samplesPerSecond, perThread, efficiency );
+                    }
+                    else
+                    {
+                        std::printf( "%-24s %-8s %-7s %-9s %7d %14.2f %18.2f %9.1f%%%s\n", tree.name.c_str(), simd, mode, placementName, threadCount,
+                            result.samplesPerSecond * 1e-6, perThread * 1e-6, efficiency * 100, result.pinned ? "" : " (pinning failed)" );
+                    }
+                    std::fflush( stdout );
+                }
+            }
+        }
+    }
+
+    return 0;
+}
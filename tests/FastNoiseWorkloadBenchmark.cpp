@@ -0,0 +1,377 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "FastNoise/FastNoise.h"
+#include "FastSIMD/FastSIMD_FastNoise_config.h"
+
+#include "PerfCounters.h"
+#include "WorkloadTrees.h"
+
+// Benchmarks every generation entry point with realistic chunk shapes, step sizes, seed patterns and position sets
+// Runs on the max supported feature set, per node type and feature set coverage is in FastNoiseBenchmark
+
+enum class SeedPattern
+{
+    Fixed,    // Same seed for every chunk
+    PerChunk, // Seed increments every chunk
+    Random    // Random seed every chunk
+};
+
+static const char* kSeedPatternStrings[] = { "Fixed", "PerChunk", "Random" };
+
+struct PositionSet
+{
+    std::vector<float> x, y, z, w;
+};
+
+static const size_t gPositionCount = 8192;
+static const size_t gSingleCount = 1024;
+static PositionSet gDiagonalPositions;
+static PositionSet gScatteredPositions;
+
+static void BuildPositionSets()
+{
+    // Scattered positions avoid the coherent hashing and caching of positions along a line
+    std::mt19937 rng( 1337 );
+    std::uniform_real_distribution<float> dist( -4096.0f, 4096.0f );
+
+    for( PositionSet* set : { &gDiagonalPositions, &gScatteredPositions } )
+    {
+        for( auto* axis : { &set->x, &set->y, &set->z, &set->w } )
+        {
+            axis->resize( gPositionCount );
+        }
+    }
+
+    for( size_t idx = 0; idx < gPositionCount; idx++ )
+    {
+        gDiagonalPositions.x[idx] = gDiagonalPositions.y[idx] = gDiagonalPositions.z[idx] = gDiagonalPositions.w[idx] = (float)idx * 0.6f;
+
+        gScatteredPositions.x[idx] = dist( rng );
+        gScatteredPositions.y[idx] = dist( rng );
+        gScatteredPositions.z[idx] = dist( rng );
+        gScatteredPositions.w[idx] = dist( rng );
+    }
+}
+
+class SeedGenerator
+{
+public:
+    SeedGenerator( SeedPattern pattern, int threadIndex ) :
+        mPattern( pattern ), mSeed( threadIndex * 7919 ), mRng( (unsigned)threadIndex ) { }
+
+    int Next()
+    {
+        switch( mPattern )
+        {
+        case SeedPattern::Fixed:
+            return 1337;
+        case SeedPattern::PerChunk:
+            return mSeed++;
+        case SeedPattern::Random:
+            return (int)mRng();
+        }
+        return 0;
+    }
+
+private:
+    SeedPattern mPattern;
+    int mSeed;
+    std::mt19937 mRng;
+};
+
+// Reports ns/sample and samples/s per thread, items_per_second is the total across all threads
+static void SetSampleCounters( benchmark::State& state, size_t samples )
+{
+    state.SetItemsProcessed( (int64_t)samples );
+    state.counters["ns/sample"] = benchmark::Counter( (double)samples * 1e-9, benchmark::Counter::kIsRate | benchmark::Counter::kInvert | benchmark::Counter::kAvgThreads );
+    state.counters["samples/s/core"] = benchmark::Counter( (double)samples, benchmark::Counter::kIsRate | benchmark::Counter::kAvgThreads );
+}
+
+static FastNoise::SmartNode<> CreateOrSkip( benchmark::State& state, const WorkloadTree& tree )
+{
+    FastNoise::SmartNode<> generator = tree.create( FastSIMD::FeatureSet::Max );
+
+    if( !generator )
+    {
+        state.SkipWithError( "Could not create node tree" );
+    }
+    return generator;
+}
+
+static void BenchUniformGrid( benchmark::State& state, const WorkloadTree& tree, std::vector<int> counts, float stepSize, SeedPattern seedPattern )
+{
+    FastNoise::SmartNode<> generator = CreateOrSkip( state, tree );
+    if( !generator ) return;
+
+    size_t chunkSize = 1;
+    for( int count : counts )
+    {
+        chunkSize *= (size_t)count;
+    }
+
+    std::vector<float> data( chunkSize );
+    SeedGenerator seeds( seedPattern, state.thread_index );
+    size_t totalData = 0;
+
+    // Walk along X so every chunk generates new positions
+    int chunkIdx = state.thread_index * 100000;
+
+    PerfCounters perfCounters;
+
+    for( auto _ : state )
+    {
+        (void)_;
+        float xOffset = (float)( chunkIdx++ * counts[0] ) * stepSize;
+
+        switch( counts.size() )
+        {
+        case 2:
+            generator->GenUniformGrid2D( data.data(), xOffset, 0, counts[0], counts[1], stepSize, stepSize, seeds.Next() );
+            break;
+        case 3:
+            generator->GenUniformGrid3D( data.data(), xOffset, 0, 0, counts[0], counts[1], counts[2], stepSize, stepSize, stepSize, seeds.Next() );
+            break;
+        case 4:
+            generator->GenUniformGrid4D( data.data(), xOffset, 0, 0, 0, counts[0], counts[1], counts[2], counts[3], stepSize, stepSize, stepSize, stepSize, seeds.Next() );
+            break;
+        }
+        totalData += chunkSize;
+    }
+
+    perfCounters.Report( state, totalData );
+    SetSampleCounters( state, totalData );
+}
+
+static void BenchTileable2D( benchmark::State& state, const WorkloadTree& tree, int size, float stepSize, SeedPattern seedPattern )
+{
+    FastNoise::SmartNode<> generator = CreateOrSkip( state, tree );
+    if( !generator ) return;
+
+    std::vector<float> data( (size_t)size * size );
+    SeedGenerator seeds( seedPattern, state.thread_index );
+    size_t totalData = 0;
+
+    PerfCounters perfCounters;
+
+    for( auto _ : state )
+    {
+        (void)_;
+        generator->GenTileable2D( data.data(), size, size, stepSize, stepSize, seeds.Next() );
+        totalData += data.size();
+    }
+
+    perfCounters.Report( state, totalData );
+    SetSampleCounters( state, totalData );
+}
+
+static void BenchPositionArray( benchmark::State& state, const WorkloadTree& tree, int dimensions, const PositionSet& positions, SeedPattern seedPattern )
+{
+    FastNoise::SmartNode<> generator = CreateOrSkip( state, tree );
+    if( !generator ) return;
+
+    std::vector<float> data( gPositionCount );
+    SeedGenerator seeds( seedPattern, state.thread_index );
+    size_t totalData = 0;
+    float offset = (float)state.thread_index * 10000.0f;
+
+    PerfCounters perfCounters;
+
+    for( auto _ : state )
+    {
+        (void)_;
+        switch( dimensions )
+        {
+        case 2:
+            generator->GenPositionArray2D( data.data(), (int)gPositionCount, positions.x.data(), positions.y.data(), offset, 0, seeds.Next() );
+            break;
+        case 3:
+            generator->GenPositionArray3D( data.data(), (int)gPositionCount, positions.x.data(), positions.y.data(), positions.z.data(), offset, 0, 0, seeds.Next() );
+            break;
+        case 4:
+            generator->GenPositionArray4D( data.data(), (int)gPositionCount, positions.x.data(), positions.y.data(), positions.z.data(), positions.w.data(), offset, 0, 0, 0, seeds.Next() );
+            break;
+        }
+        totalData += gPositionCount;
+    }
+
+    perfCounters.Report( state, totalData );
+    SetSampleCounters( state, totalData );
+}
+
+static void BenchSingle( benchmark::State& state, const WorkloadTree& tree, int dimensions, SeedPattern seedPattern )
+{
+    FastNoise::SmartNode<> generator = CreateOrSkip( state, tree );
+    if( !generator ) return;
+
+    const PositionSet& positions = gScatteredPositions;
+    SeedGenerator seeds( seedPattern, state.thread_index );
+    size_t totalData = 0;
+    size_t positionIdx = 0;
+
+    PerfCounters perfCounters;
+
+    for( auto _ : state )
+    {
+        (void)_;
+        int seed = seeds.Next();
+        float sum = 0;
+
+        for( size_t i = 0; i < gSingleCount; i++, positionIdx = ( positionIdx + 1 ) % gPositionCount )
+        {
+            switch( dimensions )
+            {
+            case 2:
+                sum += generator->GenSingle2D( positions.x[positionIdx], positions.y[positionIdx], seed );
+                break;
+            case 3:
+                sum += generator->GenSingle3D( positions.x[positionIdx], positions.y[positionIdx], positions.z[positionIdx], seed );
+                break;
+            case 4:
+                sum += generator->GenSingle4D( positions.x[positionIdx], positions.y[positionIdx], positions.z[positionIdx], positions.w[positionIdx], seed );
+                break;
+            }
+        }
+        benchmark::DoNotOptimize( sum );
+        totalData += gSingleCount;
+    }
+
+    perfCounters.Report( state, totalData );
+    SetSampleCounters( state, totalData );
+}
+
+static std::string ShapeString( const std::vector<int>& counts )
+{
+    std::string shape;
+    for( int count : counts )
+    {
+        if( !shape.empty() )
+        {
+            shape += 'x';
+        }
+        shape += std::to_string( count );
+    }
+    return shape;
+}
+
+static std::string StepString( float stepSize )
+{
+    std::string step = std::to_string( stepSize );
+    step.erase( step.find_last_not_of( '0' ) + 1 );
+    if( step.back() == '.' )
+    {
+        step.pop_back();
+    }
+    return "step:" + step;
+}
+
+template<typename T>
+static void Register( const std::string& name, bool threaded, T&& func )
+{
+    benchmark::internal::Benchmark* bench = benchmark::RegisterBenchmark( name.c_str(), std::forward<T>( func ) );
+
+    if( threaded )
+    {
+        bench->ThreadRange( 1, (int)std::max( std::thread::hardware_concurrency(), 1u ) )->UseRealTime();
+    }
+}
+
+static void RegisterWorkloadBenchmarks( const std::vector<WorkloadTree>& trees )
+{
+    const std::vector<std::vector<int>> uniformGridShapes =
+    {
+        { 64, 64 }, { 256, 256 }, { 1024, 1024 },
+        { 16, 16, 16 }, { 32, 32, 32 }, { 64, 64, 64 },
+        { 8, 8, 8, 8 }, { 16, 16, 16, 16 },
+    };
+
+    // Shapes used for the step size and seed pattern sweeps
+    const std::vector<std::vector<int>> sweepShapes = { { 256, 256 }, { 32, 32, 32 } };
+    const float stepSizes[] = { 0.25f, 1.0f, 8.0f };
+    const SeedPattern seedPatterns[] = { SeedPattern::Fixed, SeedPattern::PerChunk, SeedPattern::Random };
+    const int tileableSizes[] = { 128, 512 };
+
+    for( const WorkloadTree& tree : trees )
+    {
+        for( const auto& counts : uniformGridShapes )
+        {
+            std::string name = "UniformGrid" + std::to_string( counts.size() ) + "D/" + ShapeString( counts ) + '/' + StepString( 1.0f ) + "/seed:PerChunk/" + tree.name;
+
+            Register( name, false, [&tree, counts]( benchmark::State& st ) { BenchUniformGrid( st, tree, counts, 1.0f, SeedPattern::PerChunk ); } );
+        }
+
+        for( const auto& counts : sweepShapes )
+        {
+            for( float stepSize : stepSizes )
+            {
+                for( SeedPattern seedPattern : seedPatterns )
+                {
+                    if( stepSize == 1.0f && seedPattern == SeedPattern::PerChunk )
+                    {
+                        continue; // Covered above
+                    }
+
+                    std::string name = "UniformGrid" + std::to_string( counts.size() ) + "D/" + ShapeString( counts ) + '/' + StepString( stepSize ) +
+                        "/seed:" + kSeedPatternStrings[(int)seedPattern] + '/' + tree.name;
+
+                    Register( name, false, [&tree, counts, stepSize, seedPattern]( benchmark::State& st ) { BenchUniformGrid( st, tree, counts, stepSize, seedPattern ); } );
+                }
+            }
+        }
+
+        for( int size : tileableSizes )
+        {
+            std::string name = "Tileable2D/" + ShapeString( { size, size } ) + '/' + StepString( 1.0f ) + "/seed:PerChunk/" + tree.name;
+
+            Register( name, false, [&tree, size]( benchmark::State& st ) { BenchTileable2D( st, tree, size, 1.0f, SeedPattern::PerChunk ); } );
+        }
+
+        for( int dimensions = 2; dimensions <= 4; dimensions++ )
+        {
+            for( const PositionSet* positions : { &gDiagonalPositions, &gScatteredPositions } )
+            {
+                std::string name = "PositionArray" + std::to_string( dimensions ) + "D/" + ( positions == &gScatteredPositions ? "Scattered" : "Diagonal" ) + "/seed:PerChunk/" + tree.name;
+
+                Register( name, false, [&tree, dimensions, positions]( benchmark::State& st ) { BenchPositionArray( st, tree, dimensions, *positions, SeedPattern::PerChunk ); } );
+            }
+
+            std::string name = "Single" + std::to_string( dimensions ) + "D/Scattered/seed:Fixed/" + tree.name;
+
+            Register( name, false, [&tree, dimensions]( benchmark::State& st ) { BenchSingle( st, tree, dimensions, SeedPattern::Fixed ); } );
+        }
+    }
+
+    // Multi-thread scaling, each thread creates its own copy of the node tree
+    // FastNoiseScalingBenchmark covers shared trees, thread pinning and parallel efficiency
+    for( const WorkloadTree& tree : trees )
+    {
+        std::vector<int> counts = { 32, 32, 32 };
+
+        Register( "Threaded/UniformGrid3D/32x32x32/step:1/seed:PerChunk/" + tree.name, true, [&tree, counts]( benchmark::State& st ) { BenchUniformGrid( st, tree, counts, 1.0f, SeedPattern::PerChunk ); } );
+
+        Register( "Threaded/PositionArray3D/Scattered/seed:PerChunk/" + tree.name, true, [&tree]( benchmark::State& st ) { BenchPositionArray( st, tree, 3, gScatteredPositions, SeedPattern::PerChunk ); } );
+    }
+}
+
+int main( int argc, char** argv )
+{
+    std::cout << "FastSIMD Max Supported Feature Set: " << FastSIMD::GetFeatureSetString( FastSIMD::DetectCpuMaxFeatureSet() ) << std::endl;
+
+    PerfCounters::ParseArguments( argc, argv );
+    benchmark::Initialize( &argc, argv );
+
+    BuildPositionSets();
+
+    static const std::vector<WorkloadTree> trees = BuildWorkloadTrees();
+
+    RegisterWorkloadBenchmarks( trees );
+
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
@@ -0,0 +1,269 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#if defined( __linux__ )
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define FASTNOISE_BENCHMARK_PERF_EVENTS
+#endif
+
+// Hardware performance counters for benchmarks, enabled with the --perf_counters argument
+// Counts Linux perf events on the benchmarking thread and reports them per sample as benchmark counters:
+//   insn/sample, cycles/sample, IPC, L1D-miss/sample, LLC-miss/sample, br-miss/sample, GHz
+// High IPC with few misses is compute bound, rising LLC-miss/sample with array size is memory bound
+// Events that can not be opened are left out, for example when perf_event_paranoid is too restrictive,
+// in virtual machines without a virtual PMU, or on platforms other than Linux
+class PerfCounters
+{
+public:
+    enum Event
+    {
+        Cycles,
+        Instructions,
+        BranchMisses,
+        L1DMisses,
+        LLCMisses,
+        TaskClock,
+        EventCount
+    };
+
+    // Removes --perf_counters from the arguments, call before benchmark::Initialize()
+    static void ParseArguments( int& argc, char** argv )
+    {
+        int outIdx = 1;
+
+        for( int i = 1; i < argc; i++ )
+        {
+            if( std::strcmp( argv[i], "--perf_counters" ) == 0 )
+            {
+                Enabled() = true;
+            }
+            else
+            {
+                argv[outIdx++] = argv[i];
+            }
+        }
+        argc = outIdx;
+    }
+
+    // Opens and starts counting events for the calling thread, does nothing unless enabled
+    PerfCounters()
+    {
+        for( int& fd : mFds )
+        {
+            fd = -1;
+        }
+
+#ifdef FASTNOISE_BENCHMARK_PERF_EVENTS
+        if( !Enabled() )
+        {
+            return;
+        }
+
+        int openError = 0;
+
+        for( int event = 0; event < EventCount; event++ )
+        {
+            perf_event_attr attr;
+            std::memset( &attr, 0, sizeof( attr ) );
+            attr.size = sizeof( attr );
+            attr.disabled = 1;
+            attr.exclude_kernel = 1; // Allows counting with perf_event_paranoid = 2
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            switch( event )
+            {
+            case Cycles:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case Instructions:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case BranchMisses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            case L1DMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D | ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 );
+                break;
+            case LLCMisses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_LL | ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 );
+                break;
+            case TaskClock:
+                attr.type = PERF_TYPE_SOFTWARE;
+                attr.config = PERF_COUNT_SW_TASK_CLOCK;
+                break;
+            }
+
+            // Events are opened separately so one unsupported event does not disable the rest,
+            // the kernel multiplexes them if there are not enough hardware counters
+            mFds[event] = (int)syscall( __NR_perf_event_open, &attr, 0, -1, -1, 0 );
+
+            if( mFds[event] < 0 && !openError )
+            {
+                openError = errno;
+            }
+        }
+
+        for( int fd : mFds )
+        {
+            if( fd >= 0 )
+            {
+                ioctl( fd, PERF_EVENT_IOC_RESET, 0 );
+                ioctl( fd, PERF_EVENT_IOC_ENABLE, 0 );
+            }
+        }
+
+        if( openError )
+        {
+            std::string message = std::string( "Some perf counters could not be opened: " ) + std::strerror( openError );
+
+            if( openError == EACCES || openError == EPERM )
+            {
+                message += ", check /proc/sys/kernel/perf_event_paranoid";
+            }
+            else
+            {
+                message += ", the CPU or virtual machine may not expose these events";
+            }
+
+            WarnOnce( message + ". Missing counters are not reported" );
+        }
+#else
+        if( Enabled() )
+        {
+            WarnOnce( "Perf counters are only supported on Linux" );
+        }
+#endif
+    }
+
+    ~PerfCounters()
+    {
+#ifdef FASTNOISE_BENCHMARK_PERF_EVENTS
+        for( int fd : mFds )
+        {
+            if( fd >= 0 )
+            {
+                close( fd );
+            }
+        }
+#endif
+    }
+
+    PerfCounters( const PerfCounters& ) = delete;
+    PerfCounters& operator=( const PerfCounters& ) = delete;
+
+    // Stops counting and adds the available counters to the benchmark, call once after the benchmark loop
+    void Report( benchmark::State& state, size_t samples )
+    {
+        double values[EventCount];
+        bool available[EventCount];
+
+        for( int event = 0; event < EventCount; event++ )
+        {
+            available[event] = Read( event, values[event] );
+        }
+
+        if( !samples )
+        {
+            return;
+        }
+
+        // Per thread values, averaged across threads
+        auto addCounter = [&]( const char* name, double value )
+        {
+            state.counters[name] = benchmark::Counter( value, benchmark::Counter::kAvgThreads );
+        };
+
+        double perSample = 1.0 / (double)samples;
+
+        if( available[Instructions] )
+        {
+            addCounter( "insn/sample", values[Instructions] * perSample );
+        }
+        if( available[Cycles] )
+        {
+            addCounter( "cycles/sample", values[Cycles] * perSample );
+        }
+        if( available[Instructions] && available[Cycles] && values[Cycles] > 0 )
+        {
+            addCounter( "IPC", values[Instructions] / values[Cycles] );
+        }
+        if( available[L1DMisses] )
+        {
+            addCounter( "L1D-miss/sample", values[L1DMisses] * perSample );
+        }
+        if( available[LLCMisses] )
+        {
+            addCounter( "LLC-miss/sample", values[LLCMisses] * perSample );
+        }
+        if( available[BranchMisses] )
+        {
+            addCounter( "br-miss/sample", values[BranchMisses] * perSample );
+        }
+        // Average frequency while running, shows AVX frequency reduction
+        if( available[Cycles] && available[TaskClock] && values[TaskClock] > 0 )
+        {
+            addCounter( "GHz", values[Cycles] / values[TaskClock] );
+        }
+    }
+
+private:
+    static bool& Enabled()
+    {
+        static bool enabled = false;
+        return enabled;
+    }
+
+    static void WarnOnce( const std::string& message )
+    {
+        static std::once_flag once;
+        std::call_once( once, [&] { std::cerr << message << std::endl; } );
+    }
+
+    // Stops the event and returns its count, scaled up if it was multiplexed
+    bool Read( int event, double& value )
+    {
+        value = 0;
+
+#ifdef FASTNOISE_BENCHMARK_PERF_EVENTS
+        int fd = mFds[event];
+
+        if( fd < 0 )
+        {
+            return false;
+        }
+
+        ioctl( fd, PERF_EVENT_IOC_DISABLE, 0 );
+
+        uint64_t data[3]; // { value, time enabled, time running }
+
+        if( read( fd, data, sizeof( data ) ) != (ssize_t)sizeof( data ) || !data[2] )
+        {
+            return false;
+        }
+
+        value = (double)data[0] * ( (double)data[1] / (double)data[2] );
+        return true;
+#else
+        (void)event;
+        return false;
+#endif
+    }
+
+    int mFds[EventCount];
+};
@@ -0,0 +1,100 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "FastNoise/FastNoise.h"
+#include "FastNoise/Metadata.h"
+
+#include "../tools/NodeEditor/util/DemoNodeTrees.inl"
+
+// Node trees shared by the benchmarks and test harnesses
+
+// Creates a node of the given type with Constant nodes connected to its sources
+// Sources that do not accept a Constant use the first node type they accept, returns null if no valid sources are found
+inline FastNoise::SmartNode<> BuildMetadataNode( const FastNoise::Metadata* metadata, FastSIMD::FeatureSet level )
+{
+    FastNoise::SmartNode<> generator = metadata->CreateNode( level );
+
+    FastNoise::SmartNode<> source = FastNoise::New<FastNoise::Constant>( level );
+
+    for( const auto& memberNode : metadata->memberNodeLookups )
+    {
+        if( !memberNode.setFunc( generator.get(), source ) )
+        {
+            // If constant source is not valid try all other node types in order
+            for( const FastNoise::Metadata* tryMetadata : FastNoise::Metadata::GetAll() )
+            {
+                FastNoise::SmartNode<> trySource = tryMetadata->CreateNode( level );
+
+                // Other node types may also have sources
+                if( memberNode.setFunc( generator.get(), trySource ) )
+                {
+                    for( const auto& tryMemberNode : tryMetadata->memberNodeLookups )
+                    {
+                        if( !tryMemberNode.setFunc( trySource.get(), source ) )
+                        {
+                            return {};
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+    }
+    return generator;
+}
+
+struct WorkloadTree
+{
+    std::string name;
+    std::function<FastNoise::SmartNode<>( FastSIMD::FeatureSet )> create;
+};
+
+inline std::vector<WorkloadTree> BuildWorkloadTrees()
+{
+    std::vector<WorkloadTree> trees;
+
+    trees.push_back( { "Simplex", []( FastSIMD::FeatureSet level )
+    {
+        auto simplex = FastNoise::New<FastNoise::Simplex>( level );
+        simplex->SetScale( 50.0f );
+        return FastNoise::SmartNode<>( simplex );
+    } } );
+
+    trees.push_back( { "FBm Simplex 5 Octaves", []( FastSIMD::FeatureSet level )
+    {
+        auto fbm = FastNoise::New<FastNoise::FractalFBm>( level );
+        fbm->SetSource( FastNoise::New<FastNoise::Simplex>( level ) );
+        fbm->SetOctaveCount( 5 );
+        return FastNoise::SmartNode<>( fbm );
+    } } );
+
+    trees.push_back( { "Cellular Distance", []( FastSIMD::FeatureSet level )
+    {
+        auto cellular = FastNoise::New<FastNoise::CellularDistance>( level );
+        cellular->SetScale( 30.0f );
+        return FastNoise::SmartNode<>( cellular );
+    } } );
+
+    trees.push_back( { "Domain Warped FBm", []( FastSIMD::FeatureSet level )
+    {
+        auto fbm = FastNoise::New<FastNoise::FractalFBm>( level );
+        fbm->SetSource( FastNoise::New<FastNoise::Perlin>( level ) );
+        fbm->SetOctaveCount( 4 );
+
+        auto warp = FastNoise::New<FastNoise::DomainWarpGradient>( level );
+        warp->SetSource( fbm );
+        warp->SetWarpAmplitude( 30.0f );
+        return FastNoise::SmartNode<>( warp );
+    } } );
+
+    for( const auto& nodeTree : gDemoNodeTrees )
+    {
+        const char* encodedTree = nodeTree[1];
+
+        trees.push_back( { nodeTree[0], [encodedTree]( FastSIMD::FeatureSet level ) { return FastNoise::NewFromEncodedNodeTree( encodedTree, level ); } } );
+    }
+
+    return trees;
+}
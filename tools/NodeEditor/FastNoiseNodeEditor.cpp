@@ -664,6 +664,82 @@ void FastNoiseNodeEditor::DoNodeBenchmarks()
     }
 }
 
+void FastNoiseNodeEditor::ProfileSelectedNode()
+{
+    mNodeProfile.clear();
+
+    auto find = mNodes.find( mSelectedNode );
+    if( find == mNodes.end() || find->second.serialised.empty() )
+    {
+        return;
+    }
+
+    auto generator = FastNoise::NewFromEncodedNodeTree( find->second.serialised.c_str(), mMaxFeatureSet );
+
+    if( generator && FastNoise::NodeProfiler::Begin() )
+    {
+        std::vector<float> noiseData( Node::NoiseSize * Node::NoiseSize );
+
+        for( int i = 0; i < 16; i++ )
+        {
+            GenerateNodePreviewNoise( generator.get(), noiseData.data() );
+        }
+
+        FastNoise::NodeProfiler::End();
+
+        // Preview generation on other threads is also recorded, only keep this tree
+        mNodeProfile = FastNoise::NodeProfiler::GetResults( generator.get() );
+    }
+}
+
+void FastNoiseNodeEditor::DoNodeProfile()
+{
+    if( !mNodeProfileOpen )
+    {
+        return;
+    }
+
+    ImGui::SetNextWindowSize( ImVec2( 560, 300 ), ImGuiCond_FirstUseEver );
+
+    if( ImGui::Begin( "Node Profile", &mNodeProfileOpen ) )
+    {
+        if( mNodeProfile.empty() )
+        {
+            ImGui::TextUnformatted( "Select a node and use Tools > Profile Selected Node" );
+        }
+        else if( ImGui::BeginTable( "Node Profile Table", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY ) )
+        {
+            ImGui::TableSetupScrollFreeze( 0, 1 );
+            ImGui::TableSetupColumn( "Node", ImGuiTableColumnFlags_WidthStretch );
+            ImGui::TableSetupColumn( "Calls" );
+            ImGui::TableSetupColumn( "Incl ms" );
+            ImGui::TableSetupColumn( "Excl ms" );
+            ImGui::TableSetupColumn( "Excl %" );
+            ImGui::TableHeadersRow();
+
+            double totalNs = mNodeProfile.front().inclusiveNs;
+
+            for( const FastNoise::NodeProfile& profile : mNodeProfile )
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text( "%*s%s", profile.depth * 2, "", profile.name.c_str() );
+                ImGui::TableNextColumn();
+                ImGui::Text( "%llu", (unsigned long long)profile.calls );
+                ImGui::TableNextColumn();
+                ImGui::Text( "%.3f", profile.inclusiveNs / 1e6 );
+                ImGui::TableNextColumn();
+                ImGui::Text( "%.3f", profile.exclusiveNs / 1e6 );
+                ImGui::TableNextColumn();
+                ImGui::Text( "%.1f%%", totalNs > 0 ? profile.exclusiveNs / totalNs * 100.0 : 0.0 );
+            }
+
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+}
+
 void FastNoiseNodeEditor::DoIpcPolling()
 {
 #ifndef __EMSCRIPTEN__
@@ -810,6 +886,20 @@ void FastNoiseNodeEditor::Draw( const Matrix4& transformation, const Matrix4& pr
                     ImGui::EndTooltip();
                 }
 
+                if( ImGui::MenuItem( "Profile Selected Node", nullptr, false, FastNoise::NodeProfiler::IsAvailable() && mSelectedNode ) )
+                {
+                    ProfileSelectedNode();
+                    mNodeProfileOpen = true;
+                }
+                if( ImGui::IsItemHovered( ImGuiHoveredFlags_AllowWhenDisabled ) )
+                {
+                    ImGui::BeginTooltip();
+                    ImGui::TextUnformatted( FastNoise::NodeProfiler::IsAvailable() ?
+                        "Time spent in each node of the selected node tree" :
+                        "Requires FastNoise2 built with FASTNOISE2_PROFILING" );
+                    ImGui::EndTooltip();
+                }
+
                 ImGui::Separator();
 
                 if( ImGui::MenuItem( "Clear All Nodes" ) )
@@ -934,6 +1024,7 @@ void FastNoiseNodeEditor::Draw( const Matrix4& transformation, const Matrix4& pr
     ImGui::End();
 
     DoNodeBenchmarks();
+    DoNodeProfile();
 
     if( !isDetachedNodeEditor )
     {
@@ -113,6 +113,8 @@ namespace Magnum
         void ChangeSelectedNode( FastNoise::NodeData* newId );
         void DeleteNode( FastNoise::NodeData* nodeData );
         void DoNodeBenchmarks();
+        void ProfileSelectedNode();
+        void DoNodeProfile();
         void SetupSettingsHandlers();
         void OpenStandaloneNodeGraph();
 
@@ -144,6 +146,9 @@ namespace Magnum
         int32_t mNodeBenchmarkIndex = 0;
         int32_t mNodeBenchmarkMax = 128;
 
+        std::vector<FastNoise::NodeProfile> mNodeProfile;
+        bool mNodeProfileOpen = false;
+
         float mNodeScale = 2.5f;
         int mNodeSeed = 1337;
         NoiseTexture::GenType mNodeGenType = NoiseTexture::GenType_2D;